@@ -0,0 +1,84 @@
+/* =============================================================================
+** FlappyBirby, file: bench_auto.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+
+#include "s_auto.h"
+
+// Lets the autopilot play BENCH_TICKS ticks with 1, 2, 4, ... threads up to
+// the CPU count. The budget is far more than a decision takes, so the
+// search is never cut short and every thread count plays the same game.
+#define BENCH_TICKS (SIM_TICK_RATE * 30)
+#define BENCH_BUDGET_MS 1000.0
+#define BENCH_SEED 1
+
+int main(int argc, char *argv[]) {
+    const uint numcpus = (uint)SDL_GetCPUCount();
+    SimLayout layout;
+    S_DefaultLayout(&layout);
+
+    double single = 0.0;
+    int expectedscore = 0;
+    uint expectedticks = 0;
+    printf("%8s %10s %12s %10s %10s %10s\n", "threads", "seconds", "nodes/s",
+           "avg ms", "max ms", "speedup");
+    uint threads = 1;
+    while (threads <= numcpus) {
+        AutoPilot pilot;
+        if (!S_AutoCreate(&pilot, threads, SIM_TICK_RATE, BENCH_BUDGET_MS)) {
+            fprintf(stderr, "Could not start %u threads\n", threads);
+            return EXIT_FAILURE;
+        }
+        SimState sim;
+        SimInput input;
+        S_Init(&sim, SIM_TICK_RATE, &layout, BENCH_SEED);
+        while (sim.tick < BENCH_TICKS) {
+            input.flap = S_AutoFlap(&pilot, &sim);
+            if (S_Step(&sim, &input) & SIM_EVENT_DEATH)
+                break;
+        }
+        const AutoStats stats = pilot.stats;
+        S_AutoDestroy(&pilot);
+
+        if (threads == 1) {
+            single = stats.seconds;
+            expectedscore = sim.score;
+            expectedticks = sim.tick;
+        } else if (sim.score != expectedscore || sim.tick != expectedticks) {
+            fprintf(stderr, "Game differs with %u threads\n", threads);
+            return EXIT_FAILURE;
+        }
+        printf("%8u %10.4f %12.0f %10.3f %10.3f %10.2f\n", threads,
+               stats.seconds, stats.nodes / stats.seconds,
+               stats.seconds * 1000.0 / stats.decisions, stats.maxms,
+               single / stats.seconds);
+        // Doubling, but always finish on the full count
+        threads = threads < numcpus && threads * 2 > numcpus ?
+            numcpus : threads * 2;
+    }
+    printf("autopilot: score %d, %u ticks\n", expectedscore, expectedticks);
+    return 0;
+}
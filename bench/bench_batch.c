@@ -0,0 +1,80 @@
+/* =============================================================================
+** FlappyBirby, file: bench_batch.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+
+#include "s_batch.h"
+
+// Reports environment steps per second of S_BatchStep() for a few batch
+// sizes. Dead lanes are reset every step so the batch stays full.
+#define BENCH_MIN_STEPS 2000000
+#define BENCH_SEED 1 // fixed so every run sees the same pipes
+
+static double B_RunBatch(uint count, uint steps) {
+    SimBatch batch;
+    if (!S_BatchCreate(&batch, count, SIM_TICK_RATE, NULL, BENCH_SEED)) {
+        fprintf(stderr, "Could not allocate %u lanes\n", count);
+        exit(EXIT_FAILURE);
+    }
+    Uint8 *flaps = calloc(count, 1);
+    if (flaps == NULL) {
+        fprintf(stderr, "Could not allocate %u lanes\n", count);
+        exit(EXIT_FAILURE);
+    }
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (uint s = 0; s < steps; s++) {
+        for (uint i = 0; i < count; i++) {
+            // Cheap stand-in for a policy: stay around the middle
+            flaps[i] = batch.birdy[i] > SIM_HEIGHT / 2 + SIM_PIPE_GAP;
+        }
+        if (S_BatchStep(&batch, flaps) != count) {
+            for (uint i = 0; i < count; i++) {
+                if (!batch.alive[i])
+                    S_BatchResetLane(&batch, i);
+            }
+        }
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    free(flaps);
+    S_BatchDestroy(&batch);
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+int main(int argc, char *argv[]) {
+    static const uint counts[] = { 1, 64, 4096 };
+    printf("%8s %12s %12s %16s\n", "lanes", "steps", "seconds", "env-steps/s");
+    for (uint c = 0; c < SIZEOF_ARRAY(counts); c++) {
+        const uint count = counts[c];
+        const uint steps = BENCH_MIN_STEPS / count > 100 ?
+            BENCH_MIN_STEPS / count : 100;
+        const double secs = B_RunBatch(count, steps);
+        printf("%8u %12u %12.4f %16.0f\n", count, steps, secs,
+               (double)count * steps / secs);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/* =============================================================================
+** FlappyBirby, file: bench_env.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+
+#include "s_env.h"
+
+// Reports environment steps per second of S_EnvStep() with feature and
+// with pixel observations, the way the shared library gets called. Takes
+// the bundle as first argument to rasterize the real sprites.
+#define BENCH_LANES 64
+#define BENCH_FEATURE_STEPS 20000
+#define BENCH_PIXEL_STEPS 500
+#define BENCH_DOWNSAMPLE 8
+#define BENCH_SEED 1 // fixed so every run sees the same pipes
+
+static double B_RunEnv(int obstype, const char *pakpath, uint numthreads,
+                       uint steps) {
+    SimEnv *env = S_EnvCreate(BENCH_LANES, BENCH_SEED, obstype,
+                              BENCH_DOWNSAMPLE, pakpath, numthreads);
+    if (env == NULL) {
+        fprintf(stderr, "Could not create %u lanes\n", BENCH_LANES);
+        exit(EXIT_FAILURE);
+    }
+    Uint8 *obs = malloc((size_t)BENCH_LANES * S_EnvObsSize(env));
+    Uint8 *actions = calloc(BENCH_LANES, 1);
+    Uint8 *dones = malloc(BENCH_LANES);
+    float *rewards = malloc(BENCH_LANES * sizeof(float));
+    if (obs == NULL || actions == NULL || dones == NULL || rewards == NULL) {
+        fprintf(stderr, "Could not allocate %u lanes\n", BENCH_LANES);
+        exit(EXIT_FAILURE);
+    }
+    S_EnvReset(env, BENCH_SEED, obs);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (uint s = 0; s < steps; s++) {
+        for (uint i = 0; i < BENCH_LANES; i++) {
+            // Cheap stand-in for a policy: stay around the middle
+            actions[i] = env->batch.birdy[i] > SIM_HEIGHT / 2 + SIM_PIPE_GAP;
+        }
+        S_EnvStep(env, actions, obs, rewards, dones);
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    free(obs);
+    free(actions);
+    free(dones);
+    free(rewards);
+    S_EnvDestroy(env);
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+int main(int argc, char *argv[]) {
+    const char *pakpath = argc > 1 ? argv[1] : NULL;
+    printf("%-12s %8s %12s %12s %16s\n", "obs", "threads", "steps", "seconds",
+           "env-steps/s");
+    double secs = B_RunEnv(ENV_OBS_FEATURES, NULL, 1, BENCH_FEATURE_STEPS);
+    printf("%-12s %8u %12u %12.4f %16.0f\n", "features", 1,
+           BENCH_FEATURE_STEPS, secs,
+           (double)BENCH_LANES * BENCH_FEATURE_STEPS / secs);
+    // Rendered on the calling thread, then on a pool with a worker per core
+    static const uint threads[] = { 1, 0 };
+    for (uint t = 0; t < SIZEOF_ARRAY(threads); t++) {
+        secs = B_RunEnv(ENV_OBS_PIXELS, pakpath, threads[t],
+                        BENCH_PIXEL_STEPS);
+        printf("%-12s %8s %12u %12.4f %16.0f\n", "pixels",
+               threads[t] == 1 ? "1" : "all", BENCH_PIXEL_STEPS, secs,
+               (double)BENCH_LANES * BENCH_PIXEL_STEPS / secs);
+    }
+    return 0;
+}
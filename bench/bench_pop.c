@@ -0,0 +1,114 @@
+/* =============================================================================
+** FlappyBirby, file: bench_pop.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+
+#include "s_pop.h"
+
+// Evaluates one generation of random controllers with 1, 2, 4, ... threads
+// up to the CPU count and reports the speedup over a single thread. Every
+// thread count must come up with the same fitness.
+#define BENCH_POPULATION 2048
+#define BENCH_MAX_TICKS 20000
+#define BENCH_SEED 1
+
+static Uint64 B_Checksum(const Fitness *fitness, uint count) {
+    Uint64 sum = 0;
+    for (uint i = 0; i < count; i++) {
+        sum = sum * 31 + (Uint64)fitness[i].score * 100003 + fitness[i].ticks;
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[]) {
+    const uint numcpus = (uint)SDL_GetCPUCount();
+    Controller *controllers = malloc(BENCH_POPULATION * sizeof(Controller));
+    Fitness *fitness = malloc(BENCH_POPULATION * sizeof(Fitness));
+    if (controllers == NULL || fitness == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    RandomState rng;
+    U_RandomSeed(&rng, BENCH_SEED, 0);
+    for (uint i = 0; i < BENCH_POPULATION; i++) {
+        for (uint w = 0; w < POP_NUM_WEIGHTS; w++) {
+            controllers[i].weights[w] =
+                (float)U_RandomRange(&rng, -1000, 1000) / 1000.0f;
+        }
+    }
+    PopConfig config;
+    config.tickrate = SIM_TICK_RATE;
+    S_DefaultLayout(&config.layout);
+    config.seed = BENCH_SEED;
+    config.maxticks = BENCH_MAX_TICKS;
+
+    double single = 0.0;
+    Uint64 expected = 0;
+    printf("%8s %10s %12s %10s %10s\n", "threads", "seconds", "games/s",
+           "speedup", "efficiency");
+    uint threads = 1;
+    while (threads <= numcpus) {
+        Pool pool;
+        if (!U_PoolCreate(&pool, threads)) {
+            fprintf(stderr, "Could not start %u threads\n", threads);
+            return EXIT_FAILURE;
+        }
+        const Uint64 start = SDL_GetPerformanceCounter();
+        S_PopEvaluate(&pool, &config, controllers, fitness, BENCH_POPULATION);
+        const Uint64 end = SDL_GetPerformanceCounter();
+        U_PoolDestroy(&pool);
+
+        const double secs = (double)(end - start) /
+            (double)SDL_GetPerformanceFrequency();
+        const Uint64 checksum = B_Checksum(fitness, BENCH_POPULATION);
+        if (threads == 1) {
+            single = secs;
+            expected = checksum;
+        } else if (checksum != expected) {
+            fprintf(stderr, "Fitness differs with %u threads\n", threads);
+            return EXIT_FAILURE;
+        }
+        printf("%8u %10.4f %12.0f %10.2f %9.0f%%\n", threads, secs,
+               BENCH_POPULATION / secs, single / secs,
+               100.0 * single / secs / threads);
+        // Doubling, but always finish on the full count
+        threads = threads < numcpus && threads * 2 > numcpus ?
+            numcpus : threads * 2;
+    }
+
+    uint best = 0;
+    for (uint i = 1; i < BENCH_POPULATION; i++) {
+        if (fitness[i].score > fitness[best].score ||
+            (fitness[i].score == fitness[best].score &&
+             fitness[i].ticks > fitness[best].ticks))
+            best = i;
+    }
+    printf("best controller: score %d, %u ticks\n", fitness[best].score,
+           fitness[best].ticks);
+    free(controllers);
+    free(fitness);
+    return 0;
+}
@@ -0,0 +1,223 @@
+/* =============================================================================
+** FlappyBirby, file: a_mix.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "a_mix.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const MixSound *sound;
+    Uint32 position;
+} MixVoice;
+
+typedef struct {
+    const MixSound *sound;
+    Uint64 stamp;
+} MixRequest;
+
+static void SDLCALL A_MixCallback(void *userdata, Uint8 *stream, int len);
+static void A_MixStart(const MixRequest *request);
+
+static SDL_AudioDeviceID device = 0;
+static SDL_AudioSpec spec;
+static MixVoice voices[MIX_VOICES]; // only touched by the callback
+// Single producer (A_MixPlay) and single consumer (the callback)
+static MixRequest queue[MIX_QUEUE];
+static SDL_atomic_t queuehead; // next slot A_MixPlay() writes
+static SDL_atomic_t queuetail; // next slot the callback reads
+// Written by the callback, read once the device is closed
+static Uint64 latencymin, latencymax, latencysum;
+static uint numplayed, numstolen;
+
+// samples is the device buffer in sample frames, the smaller the sooner a
+// sound is heard. The format is not allowed to change so that sounds
+// converted for it can be mixed as they are.
+boolean A_MixOpen(int frequency, SDL_AudioFormat format, int channels,
+                  int samples) {
+    SDL_AudioSpec desired;
+    SDL_zero(desired);
+    desired.freq = frequency;
+    desired.format = format;
+    desired.channels = (Uint8)channels;
+    desired.samples = (Uint16)samples;
+    desired.callback = A_MixCallback;
+    SDL_AtomicSet(&queuehead, 0);
+    SDL_AtomicSet(&queuetail, 0);
+    memset(voices, 0, sizeof(voices));
+    latencymin = (Uint64)-1;
+    latencymax = latencysum = 0;
+    numplayed = numstolen = 0;
+    device = SDL_OpenAudioDevice(NULL, 0, &desired, &spec, 0);
+    if (device == 0)
+        return false;
+    SDL_PauseAudioDevice(device, 0);
+    return true;
+}
+
+void A_MixClose(void) {
+    if (device != 0) {
+        SDL_CloseAudioDevice(device);
+        device = 0;
+    }
+}
+
+boolean A_MixIsOpen(void) {
+    return device != 0;
+}
+
+void A_MixSpec(int *frequency, SDL_AudioFormat *format, int *channels,
+               int *samples) {
+    *frequency = spec.freq;
+    *format = spec.format;
+    *channels = spec.channels;
+    *samples = spec.samples;
+}
+
+// Loads a wav and converts it to the device format, safe to call from the
+// loader thread once A_MixOpen() returned.
+boolean A_MixLoadWAV(MixSound *sound, const char *path) {
+    SDL_AudioSpec wavspec;
+    SDL_AudioCVT cvt;
+    Uint8 *buf = NULL;
+    Uint32 len = 0;
+
+    sound->data = sound->owned = NULL;
+    sound->length = 0;
+    if (SDL_LoadWAV(path, &wavspec, &buf, &len) == NULL)
+        return false;
+    if (SDL_BuildAudioCVT(&cvt, wavspec.format, wavspec.channels,
+                          wavspec.freq, spec.format, spec.channels,
+                          spec.freq) < 0) {
+        SDL_FreeWAV(buf);
+        return false;
+    }
+    cvt.len = (int)len;
+    cvt.buf = malloc((size_t)len * (cvt.len_mult > 0 ? cvt.len_mult : 1));
+    if (cvt.buf == NULL) {
+        SDL_FreeWAV(buf);
+        return false;
+    }
+    memcpy(cvt.buf, buf, len);
+    SDL_FreeWAV(buf);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        free(cvt.buf);
+        return false;
+    }
+    sound->data = sound->owned = cvt.buf;
+    sound->length = cvt.needed ? (Uint32)cvt.len_cvt : len;
+    return true;
+}
+
+// For samples that already are in the device format, e.g. in the pak.
+void A_MixBorrow(MixSound *sound, const Uint8 *data, Uint32 length) {
+    sound->data = data;
+    sound->length = length;
+    sound->owned = NULL;
+}
+
+// The device must be closed or the sound no longer playing.
+void A_MixFree(MixSound *sound) {
+    free(sound->owned);
+    sound->data = sound->owned = NULL;
+    sound->length = 0;
+}
+
+// stamp is the SDL_GetPerformanceCounter() time of whatever caused the
+// sound, e.g. the key press. Never blocks; drops the sound when the queue
+// is full.
+void A_MixPlay(const MixSound *sound, Uint64 stamp) {
+    const int head = SDL_AtomicGet(&queuehead);
+    const int tail = SDL_AtomicGet(&queuetail);
+    if (device == 0 || sound == NULL || sound->data == NULL ||
+        head - tail >= MIX_QUEUE)
+        return;
+    queue[head & (MIX_QUEUE - 1)].sound = sound;
+    queue[head & (MIX_QUEUE - 1)].stamp = stamp;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&queuehead, head + 1);
+}
+
+// Only meaningful after A_MixClose(), the callback updates these unlocked.
+void A_MixGetStats(MixStats *stats) {
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    stats->played = numplayed;
+    stats->stolen = numstolen;
+    stats->minms = numplayed > 0 ? latencymin * 1000.0 / frequency : 0.0;
+    stats->avgms = numplayed > 0 ?
+        latencysum * 1000.0 / frequency / numplayed : 0.0;
+    stats->maxms = latencymax * 1000.0 / frequency;
+}
+
+static void SDLCALL A_MixCallback(void *userdata, Uint8 *stream, int len) {
+    const int head = SDL_AtomicGet(&queuehead);
+    SDL_MemoryBarrierAcquire();
+    int tail = SDL_AtomicGet(&queuetail);
+    for (; tail != head; tail++) {
+        A_MixStart(&queue[tail & (MIX_QUEUE - 1)]);
+    }
+    SDL_AtomicSet(&queuetail, tail);
+
+    memset(stream, spec.silence, (size_t)len);
+    for (uint i = 0; i < MIX_VOICES; i++) {
+        MixVoice *voice = &voices[i];
+        if (voice->sound == NULL)
+            continue;
+        Uint32 left = voice->sound->length - voice->position;
+        if (left > (Uint32)len)
+            left = (Uint32)len;
+        SDL_MixAudioFormat(stream, voice->sound->data + voice->position,
+                           spec.format, left, MIX_VOLUME);
+        voice->position += left;
+        if (voice->position >= voice->sound->length)
+            voice->sound = NULL;
+    }
+}
+
+// Puts a request on a free voice, or on the one that played the longest.
+static void A_MixStart(const MixRequest *request) {
+    MixVoice *target = NULL;
+    for (uint i = 0; i < MIX_VOICES && target == NULL; i++) {
+        if (voices[i].sound == NULL)
+            target = &voices[i];
+    }
+    if (target == NULL) {
+        target = &voices[0];
+        for (uint i = 1; i < MIX_VOICES; i++) {
+            if (voices[i].position > target->position)
+                target = &voices[i];
+        }
+        numstolen++;
+    }
+    target->sound = request->sound;
+    target->position = 0;
+
+    const Uint64 latency = SDL_GetPerformanceCounter() - request->stamp;
+    if (latency < latencymin)
+        latencymin = latency;
+    if (latency > latencymax)
+        latencymax = latency;
+    latencysum += latency;
+    numplayed++;
+}
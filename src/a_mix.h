@@ -0,0 +1,66 @@
+/* =============================================================================
+** FlappyBirby, file: a_mix.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __A_MIX_H__
+#define __A_MIX_H__
+
+#include "u_utility.h"
+
+// Small sound effect mixer for the low latency mode. Sounds are converted
+// to the device format when loaded, so the audio callback only adds them
+// up. A_MixPlay() hands sounds to the callback through a lock-free queue;
+// when all voices are busy the one furthest along is taken over.
+#define MIX_VOICES 8
+#define MIX_QUEUE 32 // plays in flight between two callbacks, power of two
+#define MIX_VOLUME 5 // of SDL_MIX_MAXVOLUME, as loud as the SDL_mixer path
+
+typedef struct {
+    const Uint8 *data; // in the device format
+    Uint32 length; // bytes
+    Uint8 *owned; // freed by A_MixFree(), NULL when data is borrowed
+} MixSound;
+
+// Time from the stamp given to A_MixPlay() until the callback started
+// writing the sound into the device buffer.
+typedef struct {
+    uint played;
+    uint stolen; // voices taken over from a sound still playing
+    double minms;
+    double avgms;
+    double maxms;
+} MixStats;
+
+boolean A_MixOpen(int frequency, SDL_AudioFormat format, int channels,
+                  int samples);
+void A_MixClose(void);
+boolean A_MixIsOpen(void);
+void A_MixSpec(int *frequency, SDL_AudioFormat *format, int *channels,
+               int *samples);
+boolean A_MixLoadWAV(MixSound *sound, const char *path);
+void A_MixBorrow(MixSound *sound, const Uint8 *data, Uint32 length);
+void A_MixFree(MixSound *sound);
+void A_MixPlay(const MixSound *sound, Uint64 stamp);
+void A_MixGetStats(MixStats *stats);
+
+#endif
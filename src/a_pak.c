@@ -0,0 +1,140 @@
+/* =============================================================================
+** FlappyBirby, file: a_pak.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "a_pak.h"
+
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static boolean A_PakMap(Pak *pak, const char *path);
+static boolean A_PakValidate(const Pak *pak);
+
+boolean A_PakOpen(Pak *pak, const char *path) {
+    memset(pak, 0, sizeof(*pak));
+    if (!A_PakMap(pak, path))
+        return false;
+    if (!A_PakValidate(pak)) {
+        A_PakClose(pak);
+        return false;
+    }
+    pak->header = (const PakHeader *)pak->data;
+    pak->entries = (const PakEntry *)(pak->data + sizeof(PakHeader));
+    return true;
+}
+
+void A_PakClose(Pak *pak) {
+    if (pak->data == NULL)
+        return;
+#ifndef _WIN32
+    if (pak->mapped) {
+        munmap((void *)pak->data, pak->size);
+    } else
+#endif
+    {
+        SDL_free((void *)pak->data);
+    }
+    memset(pak, 0, sizeof(*pak));
+}
+
+const PakEntry *A_PakFind(const Pak *pak, const char *name, PakType type) {
+    for (Uint32 i = 0; i < pak->header->numentries; i++) {
+        const PakEntry *entry = &pak->entries[i];
+        if (entry->type == (Uint32)type &&
+            strncmp(entry->name, name, PAK_NAME_LEN) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+const void *A_PakAtlas(const Pak *pak) {
+    return pak->data + pak->header->atlasoffset;
+}
+
+const void *A_PakData(const Pak *pak, const PakEntry *entry) {
+    return pak->data + entry->offset;
+}
+
+// Maps the bundle read-only so nothing is copied until the GPU upload.
+// Platforms without mmap read it whole instead.
+static boolean A_PakMap(Pak *pak, const char *path) {
+#ifndef _WIN32
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(PakHeader)) {
+        close(fd);
+        return false;
+    }
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    pak->data = data;
+    pak->size = (size_t)st.st_size;
+    pak->mapped = true;
+#else
+    pak->data = SDL_LoadFile(path, &pak->size);
+    if (pak->data == NULL)
+        return false;
+    pak->mapped = false;
+#endif
+    return true;
+}
+
+// Everything the game dereferences has to lie inside the file.
+static boolean A_PakValidate(const Pak *pak) {
+    if (pak->size < sizeof(PakHeader))
+        return false;
+    const PakHeader *header = (const PakHeader *)pak->data;
+    if (header->magic != PAK_MAGIC || header->version != PAK_VERSION)
+        return false;
+    const size_t tableend = sizeof(PakHeader) +
+        (size_t)header->numentries * sizeof(PakEntry);
+    const size_t atlasend = (size_t)header->atlasoffset +
+        (size_t)header->atlaswidth * header->atlasheight * 4;
+    if (tableend > pak->size || atlasend > pak->size)
+        return false;
+    const PakEntry *entries = (const PakEntry *)(pak->data + sizeof(PakHeader));
+    for (Uint32 i = 0; i < header->numentries; i++) {
+        const PakEntry *entry = &entries[i];
+        if (entry->type == PAK_SPRITE) {
+            if (entry->x + entry->w > header->atlaswidth ||
+                entry->y + entry->h > header->atlasheight)
+                return false;
+        } else if ((size_t)entry->offset + entry->length > pak->size) {
+            return false;
+        }
+    }
+    return true;
+}
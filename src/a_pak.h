@@ -0,0 +1,83 @@
+/* =============================================================================
+** FlappyBirby, file: a_pak.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __A_PAK_H__
+#define __A_PAK_H__
+
+#include "u_utility.h"
+
+// Asset bundle written by tools/packer.c. Layout of the file:
+//   PakHeader | PakEntry[numentries] | RGBA atlas pixels | raw data
+// Sprites are rects inside the atlas, sounds are already converted to the
+// mixer's device format and files (the font) are stored as they are.
+#define PAK_FILENAME "birby.pak"
+#define PAK_MAGIC 0x4B415042 // "BPAK"
+#define PAK_VERSION 1
+#define PAK_ALIGN 16
+#define PAK_NAME_LEN 32
+#define PAK_AUDIO_FREQ 44100
+#define PAK_AUDIO_FORMAT AUDIO_S16SYS
+#define PAK_AUDIO_CHANNELS 2
+
+typedef enum {
+    PAK_SPRITE,
+    PAK_SOUND,
+    PAK_FILE,
+} PakType;
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 numentries;
+    Uint32 atlaswidth;
+    Uint32 atlasheight;
+    Uint32 atlasoffset; // RGBA32, pitch is atlaswidth * 4
+    Uint32 audiofreq;
+    Uint16 audioformat;
+    Uint16 audiochannels;
+} PakHeader;
+
+typedef struct {
+    char name[PAK_NAME_LEN]; // file name the entry was made from
+    Uint32 type;
+    Uint32 offset; // sounds and files, from the start of the bundle
+    Uint32 length;
+    Uint32 x, y, w, h; // sprites, inside the atlas
+} PakEntry;
+
+typedef struct {
+    const Uint8 *data;
+    size_t size;
+    const PakHeader *header;
+    const PakEntry *entries;
+    boolean mapped;
+} Pak;
+
+boolean A_PakOpen(Pak *pak, const char *path);
+void A_PakClose(Pak *pak);
+const PakEntry *A_PakFind(const Pak *pak, const char *name, PakType type);
+const void *A_PakAtlas(const Pak *pak);
+const void *A_PakData(const Pak *pak, const PakEntry *entry);
+
+#endif
@@ -31,71 +31,288 @@
 #include <SDL2/SDL_ttf.h>
 
 #include "u_utility.h"
+#include "s_sim.h"
+#include "s_replay.h"
+#include "s_snap.h"
+#include "s_auto.h"
+#include "s_ghost.h"
+#include "s_score.h"
+#include "r_batch.h"
+#include "a_pak.h"
+#include "a_mix.h"
+#include "r_ghost.h"
+#include "r_hud.h"
+#include "r_prof.h"
+#include "r_scale.h"
+#include "u_prof.h"
+#include "u_log.h"
 
 #define ASSETS_DIR "assets/"
-#define NUM_PIPES 16
 #define NUM_FRAMES 2
+#define BIRD_FRAME_W 65 // of one animation frame in the bird sprite
+#define BIRD_FRAME_H 68
+#define MAX_FRAME_MS 250.0 // longest frame the simulation catches up on
+#define FONT_SIZE 88 // texts are rendered at the size they are shown
+#define TEXT_WRAP 240
+#define HUD_Y 40
+#define BOARD_HEIGHT 48 // digits of the best scores on the game over screen
+#define BOARD_Y (SIM_HEIGHT - 2 * BOARD_HEIGHT)
+#define BENCH_FRAMES 3000
+#define BENCH_FRAME_MS (1000.0 / 60.0) // simulated time per --bench frame
+#define BENCH_SEED 1
+#define BENCH_NUM_GHOSTS 10000
+#define IDLE_TIMEOUT_MS 1000 // longest a still screen sleeps between checks
+#define DEFAULT_FPS 60 // --lateinput, when the display doesn't say
+#define AUTO_RESTART_MS 2000 // --autopilot leaves the game over screen up
+#define AUDIO_FREQ 44100
+#define AUDIO_BUFFER 2048 // sample frames, about 46 ms
+#define AUDIO_BUFFER_LOW 256 // about 6 ms, for --lowlatency
+
 // 800 / 2 + 100 = 525
 // 800 / 2 - 100 = 300
 
+enum sprite_t {
+    SPRITE_PIPE = 0,
+    SPRITE_BIRD,
+    SPRITE_BG,
+    SPRITE_GROUND,
+    NUM_SPRITES,
+};
+
+enum sound_t {
+    SOUND_FLAP = 0,
+    SOUND_SCORE,
+    SOUND_LOSE,
+    NUM_SOUNDS,
+};
+
+// Stages the loader thread goes through, the start screen only needs the
+// first two
+enum loadstage_t {
+    LOAD_FAILED = -1,
+    LOAD_NONE,
+    LOAD_SPRITES,
+    LOAD_TEXT,
+    LOAD_SOUNDS,
+};
+
+// What the frame profiler times, see U_ProfBegin()
+enum profphase_t {
+    PHASE_EVENTS = 0,
+    PHASE_SIM,
+    PHASE_ASSETS,
+    PHASE_BACKGROUND,
+    PHASE_PIPES,
+    PHASE_BIRD,
+    PHASE_GROUND,
+    PHASE_HUD,
+    PHASE_OVERLAY,
+    PHASE_BATCH, // R_BatchEnd(), where the queued quads reach the renderer
+    PHASE_SCALE, // R_ScaleEnd(), drawing a --resscale/--dynres frame
+    PHASE_PRESENT,
+    NUM_PHASES,
+};
+
+// Scripted runs for --bench
+enum benchscenario_t {
+    BENCH_NONE = 0,
+    BENCH_IDLE, // start screen, no input
+    BENCH_PLAY, // steers through the gaps for as long as it can
+    BENCH_RESTART, // dies at the first pipe and restarts right away
+    BENCH_GHOSTS, // play, raced by BENCH_NUM_GHOSTS randomly flapping ghosts
+    NUM_BENCHES,
+};
+
+typedef struct {
+    uint tickrate;
+    boolean vsync;
+    boolean drawstats;
+    boolean startupstats;
+    SimLayout layout;
+    Uint64 seed;
+    const char *recordfile; // each finished run is saved here
+    const char *playfile; // replay shown instead of taking input
+    char **verifyfiles; // replays checked headless, no window is opened
+    int numverify;
+    char **ghostfiles; // replays raced against as ghosts
+    int numghosts;
+    const char *profilefile; // trace and csv written here on exit
+    int bench;
+    uint benchframes;
+    boolean lowlatency; // own callback mixer instead of SDL_mixer
+    int audiobuffer; // sample frames, 0 picks one for the mixer in use
+    boolean audiostats;
+    boolean lateinput; // frame limiter instead of vsync, input read last
+    int fps; // --lateinput frame rate, 0 for the display's refresh rate
+    boolean inputstats;
+    boolean idle; // sleep on screens that don't change
+    float resscale; // of the offscreen target, 0 draws to the window
+    boolean dynres; // resolution follows the frame time
+    int loglevel;
+    const char *logfile; // binary log, see tools/logdump.c
+    uint rewind; // seconds of history kept for backspace, 0 for none
+    boolean autopilot; // attract mode, a search plays instead of the player
+    double autobudget; // ms per --autopilot decision
+    const char *scorefile; // high scores, NULL keeps none
+} GameConfig;
+
+typedef struct {
+    SDL_Thread *thread;
+    SDL_atomic_t stage; // last stage whose results may be read
+    boolean usepak;
+    SDL_Surface *sprites[NUM_SPRITES]; // decoded loose files
+    SDL_Surface *icon;
+    TTF_Font *font;
+    SDL_Surface *text;
+    SDL_Surface *textover;
+    Mix_Chunk *sounds[NUM_SOUNDS];
+    MixSound mixsounds[NUM_SOUNDS]; // with --lowlatency
+} AssetLoader;
+
+static boolean G_ParseArgs(int argc, char *argv[]);
+static int G_VerifyReplays(void);
+static boolean G_LoadGhosts(void);
+static void G_MakeBenchGhosts(void);
 static void G_AppendAssetPath(char *path);
-static boolean G_LoadAssets(SDL_Renderer *renderer);
+static int G_LoadWorker(void *data);
+static void G_LoadPublish(int stage);
+static int G_LoadFailed(void);
+static boolean G_StartLoading(void);
+static boolean G_PollAssets(SDL_Window *window, SDL_Renderer *renderer);
+static boolean G_OpenPak(void);
+static boolean G_OpenAudio(void);
+static boolean G_LoadSound(uint sound);
+static Mix_Chunk *G_PakSound(const char *name);
+static boolean G_UploadSprites(SDL_Window *window, SDL_Renderer *renderer);
 static boolean G_SetupFont(SDL_Renderer *renderer);
 static void G_FreeAssets(void);
+static void P_HandleEvents(SDL_Window *window, uint events);
+static void P_PlaySound(uint sound, Uint64 stamp);
+static void P_ReplayEvents(uint events);
 static void P_Start(SDL_Renderer *renderer);
-static void P_Play(SDL_Window *window, SDL_Renderer *renderer, double dt);
+static void P_Play(SDL_Renderer *renderer);
 static void P_Over(SDL_Renderer *renderer);
-static void P_ResetPlayerPos(void);
 static void R_DrawBackground(SDL_Rect *rect, SDL_Renderer *renderer);
 static void R_DrawBird(SDL_Rect *rectbird, SDL_Rect *rectanim,
 					   SDL_Renderer *renderer);
-static void R_DrawGround(SDL_Rect *rect, SDL_Renderer *renderer, double dt);
-static void R_DrawPipe(SDL_Rect *rect, SDL_Rect *rectbird,
-					   SDL_Renderer *renderer);
-static void P_GeneratePipes(void);
+static void R_DrawGhosts(SDL_Renderer *renderer);
+static void R_DrawGround(SDL_Rect *rect, SDL_Renderer *renderer);
+static void R_DrawPipe(SDL_Rect *rect, SDL_Renderer *renderer);
 static void P_UpdateScore(SDL_Window *window);
+static void P_PrintDrawStats(const RenderStats *stats);
+static void P_WriteProfile(const char *path);
+static boolean P_BenchInput(void);
+static void P_PrintBench(uint frames, double seconds);
+static void P_PrintAudioStats(void);
+static void P_PrintInputStats(void);
+static boolean P_AutoInput(void);
+static void P_PrintAutoStats(void);
+static boolean P_CanIdle(void);
+static int P_IdleTimeout(void);
 
 static char title[75] = "Flappy Birby, Score: ";
-static const uint width = 800;
-static const uint height = 600;
-static const uint pipewidth = 150;
-static const int lengthinbetween = 100;
-static const uint pipeheight = 400;
-static SDL_Rect pipes[NUM_PIPES];
+static const uint width = SIM_WIDTH;
+static const uint height = SIM_HEIGHT;
+static GameConfig config = {
+    SIM_TICK_RATE, true, false, false,
+    { SIM_PIPE_SPACING, SIM_PIPE_GAP, 0 }, 0, NULL, NULL, NULL, 0, NULL, 0,
+    NULL,
+    BENCH_NONE, BENCH_FRAMES, false, 0, false, false, 0, false, true, 0.0f,
+    false, LOG_LOG, NULL, SNAP_SECONDS, false, AUTO_BUDGET_MS, SCORE_FILENAME,
+};
+static const char *spritefiles[NUM_SPRITES] = {
+    "pipe.webp", "birbTile.webp", "bgTex.webp", "ground.webp",
+};
+static const char *soundfiles[NUM_SOUNDS] = {
+    "flap.wav", "score.wav", "lose.wav",
+};
+static const char *phasenames[NUM_PHASES] = {
+    "events", "sim", "assets", "background", "pipes", "bird", "ground", "hud",
+    "overlay", "batch", "scale", "present",
+};
+static const char *benchnames[NUM_BENCHES] = {
+    "", "idle", "play", "restart", "ghosts",
+};
+static AssetLoader loader;
+static int loadedstage = LOAD_NONE;
+static boolean assetsready = false;
+static SimState sim;
+static SimState prevsim;
+static SimState view; // sim blended between ticks, what gets drawn
+static Pak pak;
+static SDL_Texture *atlastexture = NULL; // all sprites, when loaded from pak
 static SDL_Texture *pipetexture = NULL;
-static const uint birdsize = 70;
-static boolean birdhascollided = false;
+static SDL_Rect pipesrc;
 static int curframe = 0;
 static int speed = 250;
-static boolean hasscored = false;
-static SDL_Rect bird;
 static SDL_Rect birdanim;
 static SDL_Texture *birdtexture = NULL;
+static SDL_Rect birdsrc;
+// Where each value of curframe is in the bird texture, the last one repeats
+static SDL_Rect birdframes[NUM_FRAMES + 2];
 static SDL_Texture *bgtexture = NULL;
+static SDL_Rect bgsrc;
 static SDL_Rect bgrect;
 static SDL_Texture *groundtexture = NULL;
+static SDL_Rect groundsrc;
 static SDL_Rect groundrect;
-static int score = 0;
 static TTF_Font *font = NULL;
-static SDL_Surface *textsurface = NULL;
 static SDL_Texture *texttexture = NULL;
 static SDL_Texture *textovertexture = NULL;
 static SDL_Rect textrect;
 static SDL_Rect textoverrect;
-static Mix_Chunk *flapsound = NULL;
-static Mix_Chunk *scoresound = NULL;
-static Mix_Chunk *losesound = NULL;
-static boolean loseplayedonce = false;
+static Mix_Chunk *sounds[NUM_SOUNDS];
+static MixSound mixsounds[NUM_SOUNDS];
 static boolean spacedown = false;
-GameState state;
+static Uint64 spacestamp = 0; // when the last space press was polled
+static Uint32 presstime = 0; // SDL_GetTicks() of the last press
+static boolean pressshown = true; // the last press made it to the screen
+static Uint32 pressmin = (Uint32)-1; // input to present, in ms
+static Uint32 pressmax = 0;
+static Uint32 presstotal = 0;
+static uint numpresses = 0;
+static boolean showprofile = false;
+static boolean idling = false; // the screen shown only changes with input
+static boolean redraw = true; // the window needs the frame again
+static GameState drawnstate = STATE_START; // of the last frame drawn
+static Uint32 drawnanim = 0; // bird animation step of the last frame drawn
+static Replay replay; // being recorded, or played back with --play
+static ReplayCursor replaycursor;
+static SnapRing snaps; // the current run, one snapshot per tick played
+static boolean rewinding = false; // backspace is held
+static boolean rewound = false; // this run, which keeps it off the scores
+static AutoPilot autopilot;
+static Uint32 autoover = 0; // SDL_GetTicks() when --autopilot died
+static GhostSet ghosts;
 
 int main(int argc, char *argv[]) {
+    const Uint64 launch = SDL_GetPerformanceCounter();
+    boolean firstframe = true;
+    config.seed = launch; // different pipes every launch unless --seed is given
+    if (!G_ParseArgs(argc, argv)) {
+        return EXIT_FAILURE;
+    }
+    if (!U_LogInit(config.loglevel, config.logfile)) {
+        LOG_ERROR("Could not start logging to %s\n",
+                  config.logfile != NULL ? config.logfile : "the console");
+        return EXIT_FAILURE;
+    }
+    atexit(U_LogQuit); // also on the early returns below
+    if (config.numverify > 0) {
+        return G_VerifyReplays();
+    }
+    if (config.playfile != NULL && !S_ReplayLoad(&replay, config.playfile)) {
+        LOG_ERROR("Could not load replay: %s\n", config.playfile);
+        return EXIT_FAILURE;
+    }
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
         LOG_ERROR("Could not initialize SDL: %s\n", SDL_GetError());
         return EXIT_FAILURE;
     }
-    Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048); // SDL_mixer
-    Mix_Volume(-1, 5);
+    if (!G_OpenAudio()) {
+        LOG_ERROR("Could not open audio: %s\n", SDL_GetError());
+        return EXIT_FAILURE;
+    }
 
     SDL_Window *window = SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED,
                                           SDL_WINDOWPOS_UNDEFINED, width,
@@ -104,13 +321,27 @@ int main(int argc, char *argv[]) {
         LOG_ERROR("SDL Window Creation failed: %s\n", SDL_GetError());
         return EXIT_FAILURE;
     }
-    SDL_Renderer *renderer = SDL_CreateRenderer(window, -1,
-                                                SDL_RENDERER_ACCELERATED |
-                                                SDL_RENDERER_PRESENTVSYNC);
+    Uint32 renderflags = SDL_RENDERER_ACCELERATED;
+    if (config.vsync) {
+        renderflags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, renderflags);
     if (renderer == NULL) {
         LOG_ERROR("SDL Renderer creation failed: %s\n", SDL_GetError());
         return EXIT_FAILURE;
     }
+    if ((config.lateinput || config.dynres) && config.fps == 0) {
+        SDL_DisplayMode mode;
+        config.fps = SDL_GetWindowDisplayMode(window, &mode) == 0 &&
+            mode.refresh_rate > 0 ? mode.refresh_rate : DEFAULT_FPS;
+    }
+    const boolean scaled = config.dynres || config.resscale > 0.0f;
+    if (scaled && !R_ScaleInit(renderer, width, height,
+                               config.resscale > 0.0f ? config.resscale : 1.0f,
+                               config.dynres ? 1000.0 / config.fps : 0.0)) {
+        LOG_ERROR("Render target creation failed: %s\n", SDL_GetError());
+        return EXIT_FAILURE;
+    }
 
     if (IMG_Init(IMG_INIT_WEBP) != IMG_INIT_WEBP) {
         LOG_ERROR("Image initialization failed : %s\n", SDL_GetError());
@@ -122,35 +353,80 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    if (!G_LoadAssets(renderer)) {
-        LOG_ERROR("Could not load crucial game assets.");
+    if (!G_StartLoading()) {
         return EXIT_FAILURE;
     }
 
-    SDL_Surface* icon = IMG_Load(ASSETS_DIR"birb0.webp");
-    if (icon == NULL) {
-        LOG_ERROR("SDL Icon failed to load: %s\n", SDL_GetError());
+    // important piece of initialization here
+    S_Init(&sim, config.tickrate, &config.layout, config.seed);
+    if (config.playfile != NULL) {
+        S_ReplayStart(&replaycursor, &replay, &sim);
+    }
+    prevsim = view = sim;
+    if ((config.numghosts > 0 || config.bench == BENCH_GHOSTS) &&
+        !G_LoadGhosts()) {
         return EXIT_FAILURE;
     }
-    SDL_SetWindowIcon(window, icon); SDL_FreeSurface(icon);
-
-    bird.x = 100;
-    bird.y = 250;
-    bird.w = birdsize;
-    bird.h = birdsize;
-
-    state = STATE_START; // important piece of initialization here
-    P_GeneratePipes();
+    if (config.autopilot && !S_AutoCreate(&autopilot, 0, sim.tickrate,
+                                          config.autobudget)) {
+        LOG_ERROR("Could not start the autopilot threads\n");
+        return EXIT_FAILURE;
+    }
+    // Only runs played by hand make it onto the scores
+    if (config.scorefile != NULL && config.bench == BENCH_NONE &&
+        config.playfile == NULL && !config.autopilot &&
+        !S_ScoreOpen(config.scorefile)) {
+        LOG_WARNING("Could not open the high scores: %s\n", config.scorefile);
+    }
+    if (config.rewind > 0 && config.bench == BENCH_NONE &&
+        config.playfile == NULL && !config.autopilot &&
+        !S_SnapCreate(&snaps, config.rewind * sim.tickrate)) {
+        LOG_WARNING("Not enough memory to rewind %u seconds\n", config.rewind);
+    }
 
+    if (!U_ProfInit(phasenames, NUM_PHASES)) {
+        LOG_ERROR("%d frame phases, the profiler has room for %d\n",
+                  NUM_PHASES, PROF_MAX_PHASES);
+        return EXIT_FAILURE;
+    }
+    const double tickms = 1000.0 / sim.tickrate;
+    uint benchframe = 0;
+    Uint64 benchstart = 0;
     Uint64 start = SDL_GetPerformanceCounter(), end = 0;
     double deltatime = 0;
+    double accumulator = 0;
+    const Uint64 frameticks = config.lateinput ?
+        SDL_GetPerformanceFrequency() / config.fps : 0;
+    Uint64 nextframe = start;
     boolean running = true;
     while (running) {
+        if (config.lateinput) {
+            // Wait here rather than in SDL_RenderPresent() so the input
+            // read below is as fresh as it gets when the frame is shown
+            U_WaitUntil(nextframe);
+            const Uint64 now = SDL_GetPerformanceCounter();
+            nextframe += frameticks;
+            if (nextframe < now) {
+                nextframe = now; // fell behind, don't catch up in a burst
+            }
+        }
+        if (idling) {
+            // Nothing moves until there is input or the bird's next wing
+            // beat, don't spin through identical frames until then
+            SDL_WaitEventTimeout(NULL, P_IdleTimeout());
+            start = SDL_GetPerformanceCounter();
+            accumulator = tickms; // one tick for whatever woke us up
+        }
         end = start;
         start = SDL_GetPerformanceCounter();
         deltatime = (double)((start - end) * 1000 /
 					 (double)SDL_GetPerformanceFrequency());
+        if (config.bench != BENCH_NONE) {
+            deltatime = BENCH_FRAME_MS; // same ticks every frame, every run
+        }
+        U_ProfFrame();
 
+        U_ProfBegin(PHASE_EVENTS);
 		SDL_Event event;
         while (SDL_PollEvent(&event)) {
             switch (event.type) {
@@ -161,40 +437,451 @@ int main(int argc, char *argv[]) {
                 if (event.key.repeat == 0) {
                     if (event.key.keysym.sym == SDLK_SPACE) {
                         spacedown = true;
+                        spacestamp = SDL_GetPerformanceCounter();
+                        presstime = event.key.timestamp;
                     } else if (event.key.keysym.sym == SDLK_ESCAPE) {
                         running = false;
+                    } else if (event.key.keysym.sym == SDLK_F3) {
+                        showprofile = !showprofile;
+                    } else if (event.key.keysym.sym == SDLK_BACKSPACE) {
+                        rewinding = snaps.capacity > 0;
                     }
                 } else {
                     spacedown = false;
                 }
                 break;
 			}
+            case SDL_KEYUP:
+                if (event.key.keysym.sym == SDLK_BACKSPACE) {
+                    rewinding = false;
+                }
+                break;
+            case SDL_WINDOWEVENT:
+                redraw = true; // exposed, restored and so on
+                break;
+            }
+        }
+        U_ProfEnd(PHASE_EVENTS);
+
+        U_ProfBegin(PHASE_SIM);
+        accumulator += deltatime;
+        if (accumulator > MAX_FRAME_MS) {
+            accumulator = MAX_FRAME_MS;
+        }
+        uint ticks = 0;
+        while (accumulator >= tickms) {
+            SimInput input;
+            input.flap = spacedown && assetsready;
+            spacedown = false;
+            if (config.bench != BENCH_NONE) {
+                input.flap = assetsready && P_BenchInput();
+            } else if (config.playfile != NULL) {
+                input.flap = false;
+                if (assetsready) {
+                    S_ReplayInput(&replaycursor, &sim, &input);
+                }
+            } else if (config.autopilot) {
+                input.flap = assetsready && P_AutoInput();
+            }
+            if (input.flap && (config.bench != BENCH_NONE ||
+                               config.playfile != NULL || config.autopilot)) {
+                spacestamp = SDL_GetPerformanceCounter(); // scripted press
+                presstime = SDL_GetTicks();
+            }
+            if (input.flap) {
+                pressshown = false;
+            }
+            prevsim = sim;
+            // Backwards as fast as it was played, the run branches off from
+            // wherever backspace is let go
+            const uint events = S_SnapTick(&snaps, rewinding, &sim, &input);
+            if (sim.tick < prevsim.tick) {
+                rewound = true;
+                if (config.recordfile != NULL) {
+                    S_ReplayRewind(&replay, sim.tick);
+                }
+            }
+            if (events & SIM_EVENT_RESET) {
+                S_SnapClear(&snaps); // no rewinding into the last run
             }
+            P_HandleEvents(window, events);
+            P_ReplayEvents(events);
+            accumulator -= tickms;
+            ticks++;
+        }
+        S_Interpolate(&prevsim, &sim, accumulator / tickms, &view);
+        // Back along with a rewind too, from the nearest checkpoint
+        if (ghosts.count > 0) {
+            S_GhostSeek(&ghosts, sim.tick);
+        }
+        U_ProfEnd(PHASE_SIM);
+        LOG_DEBUG("frame %.3f ms, %u ticks, tick %u, state %d, score %d\n",
+                  deltatime, ticks, sim.tick, sim.state, sim.score);
+
+        U_ProfBegin(PHASE_ASSETS);
+        const boolean wasready = assetsready;
+        if (!G_PollAssets(window, renderer)) {
+            LOG_ERROR("Could not load crucial game assets.");
+            return EXIT_FAILURE;
+        }
+        U_ProfEnd(PHASE_ASSETS);
+        if (assetsready && !wasready && config.startupstats) {
+            printf("time to ready: %.2f ms\n",
+                   (SDL_GetPerformanceCounter() - launch) * 1000.0 /
+                   SDL_GetPerformanceFrequency());
+        }
+
+        const boolean wasidling = idling;
+        const Uint32 anim = SDL_GetTicks() / (Uint32)speed;
+        idling = P_CanIdle();
+        if (wasidling && idling && !redraw && view.state == drawnstate &&
+            (view.state == STATE_OVER || anim == drawnanim)) {
+            continue; // the last frame is still on screen
         }
-        //fps++;
-        switch (state) {
+        drawnstate = view.state;
+        drawnanim = anim;
+        redraw = false;
+
+        RenderStats drawstats;
+        if (scaled) {
+            R_ScaleBegin();
+        }
+        R_BatchBegin(renderer, width, height);
+        switch (view.state) {
         case STATE_START:
             P_Start(renderer);
             break;
         case STATE_PLAY:
-            P_Play(window, renderer, deltatime);
+            P_Play(renderer);
             break;
         case STATE_OVER:
             P_Over(renderer);
             break;
         }
+        if (showprofile) {
+            U_ProfBegin(PHASE_OVERLAY);
+            R_ProfDraw(renderer, font);
+            U_ProfEnd(PHASE_OVERLAY);
+        }
+        U_ProfBegin(PHASE_BATCH);
+        R_BatchEnd(&drawstats);
+        U_ProfEnd(PHASE_BATCH);
+        if (scaled) {
+            U_ProfBegin(PHASE_SCALE);
+            R_ScaleEnd();
+            U_ProfEnd(PHASE_SCALE);
+        }
+        if (config.drawstats) {
+            P_PrintDrawStats(&drawstats);
+        }
+        U_ProfBegin(PHASE_PRESENT);
         SDL_RenderPresent(renderer);
+        U_ProfEnd(PHASE_PRESENT);
+        if (!pressshown) {
+            const Uint32 latency = SDL_GetTicks() - presstime;
+            if (latency < pressmin)
+                pressmin = latency;
+            if (latency > pressmax)
+                pressmax = latency;
+            presstotal += latency;
+            numpresses++;
+            pressshown = true;
+        }
+        if (firstframe && config.startupstats) {
+            printf("time to first frame: %.2f ms\n",
+                   (SDL_GetPerformanceCounter() - launch) * 1000.0 /
+                   SDL_GetPerformanceFrequency());
+        }
+        firstframe = false;
+
+        // Frames spent loading are not part of the benchmark
+        if (config.bench != BENCH_NONE && assetsready) {
+            if (benchframe == 0) {
+                U_ProfReset();
+                benchstart = SDL_GetPerformanceCounter();
+            } else if (benchframe == config.benchframes) {
+                U_ProfFrame();
+                const Uint64 ticks = SDL_GetPerformanceCounter() - benchstart;
+                P_PrintBench(benchframe,
+                             ticks / (double)SDL_GetPerformanceFrequency());
+                running = false;
+            }
+            benchframe++;
+        }
+    }
+    if (loader.thread != NULL) {
+        // Quit while still loading, adopt what's left so it gets freed
+        SDL_WaitThread(loader.thread, NULL);
+        loader.thread = NULL;
+        G_PollAssets(window, renderer);
     }
     SDL_DestroyTexture(texttexture);
     SDL_DestroyTexture(textovertexture);
+    R_HudFree();
+    R_ProfFree();
+    R_ScaleFree();
+    if (config.profilefile != NULL) {
+        P_WriteProfile(config.profilefile);
+    }
     TTF_CloseFont(font);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     G_FreeAssets();
+    if (config.audiostats) {
+        P_PrintAudioStats();
+    }
+    if (config.inputstats) {
+        P_PrintInputStats();
+    }
+    if (config.autopilot) {
+        P_PrintAutoStats();
+        S_AutoDestroy(&autopilot);
+    }
+    S_ReplayFree(&replay);
+    S_SnapDestroy(&snaps);
+    S_GhostDestroy(&ghosts);
+    R_GhostFree();
+    S_ScoreClose();
+    U_LogQuit();
     SDL_Quit();
     return 0;
 }
 
+static boolean G_ParseArgs(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tickrate") == 0 && i + 1 < argc) {
+            config.tickrate = (uint)strtoul(argv[++i], NULL, 10);
+            if (config.tickrate == 0) {
+                LOG_ERROR("Invalid tick rate: %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--pipespacing") == 0 && i + 1 < argc) {
+            config.layout.spacing = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pipegap") == 0 && i + 1 < argc) {
+            config.layout.gap = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--ramp") == 0 && i + 1 < argc) {
+            config.layout.rampscore = (uint)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            config.recordfile = argv[++i];
+        } else if (strcmp(argv[i], "--play") == 0 && i + 1 < argc) {
+            config.playfile = argv[++i];
+        } else if (strcmp(argv[i], "--verify") == 0 && i + 1 < argc) {
+            // Everything after it is a replay file
+            config.verifyfiles = &argv[i + 1];
+            config.numverify = argc - i - 1;
+            break;
+        } else if (strcmp(argv[i], "--ghosts") == 0 && i + 1 < argc) {
+            // Everything after it is a replay file
+            config.ghostfiles = &argv[i + 1];
+            config.numghosts = argc - i - 1;
+            break;
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            config.profilefile = argv[++i];
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            i++;
+            for (config.bench = NUM_BENCHES - 1; config.bench > BENCH_NONE;
+                 config.bench--) {
+                if (strcmp(argv[i], benchnames[config.bench]) == 0)
+                    break;
+            }
+            if (config.bench == BENCH_NONE) {
+                LOG_ERROR("Unknown benchmark: %s\n", argv[i]);
+                return false;
+            }
+            config.vsync = false;
+            config.seed = BENCH_SEED;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            config.benchframes = (uint)strtoul(argv[++i], NULL, 10);
+            if (config.benchframes == 0 ||
+                config.benchframes > PROF_RING_FRAMES) {
+                LOG_ERROR("Frames must be 1 to %d: %s\n", PROF_RING_FRAMES,
+                          argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--audiobuffer") == 0 && i + 1 < argc) {
+            config.audiobuffer = (int)strtol(argv[++i], NULL, 10);
+            // SDL wants a power of two that fits its Uint16
+            if (config.audiobuffer < 16 || config.audiobuffer > 32768 ||
+                (config.audiobuffer & (config.audiobuffer - 1)) != 0) {
+                LOG_ERROR("Audio buffer must be a power of two, 16 to 32768: "
+                          "%s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--lowlatency") == 0) {
+            config.lowlatency = true;
+        } else if (strcmp(argv[i], "--audiostats") == 0) {
+            config.lowlatency = true; // only the callback mixer can measure
+            config.audiostats = true;
+        } else if (strcmp(argv[i], "--autopilot") == 0) {
+            config.autopilot = true;
+        } else if (strcmp(argv[i], "--autobudget") == 0 && i + 1 < argc) {
+            config.autopilot = true;
+            config.autobudget = strtod(argv[++i], NULL);
+            if (config.autobudget <= 0.0) {
+                LOG_ERROR("Invalid autopilot budget: %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--lateinput") == 0) {
+            config.lateinput = true;
+            config.vsync = false;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            config.fps = (int)strtol(argv[++i], NULL, 10);
+            if (config.fps <= 0) {
+                LOG_ERROR("Invalid frame rate: %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--inputstats") == 0) {
+            config.inputstats = true;
+        } else if (strcmp(argv[i], "--resscale") == 0 && i + 1 < argc) {
+            config.resscale = strtof(argv[++i], NULL);
+            if (config.resscale < R_SCALE_MIN || config.resscale > 1.0f) {
+                LOG_ERROR("Resolution scale must be %.2f to 1: %s\n",
+                          R_SCALE_MIN, argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--dynres") == 0) {
+            config.dynres = true;
+        } else if (strcmp(argv[i], "--loglevel") == 0 && i + 1 < argc) {
+            i++;
+            for (config.loglevel = NUM_LOG_TYPES - 1; config.loglevel >= 0;
+                 config.loglevel--) {
+                if (strcmp(argv[i], U_LogTypeName(config.loglevel)) == 0)
+                    break;
+            }
+            if (config.loglevel < 0) {
+                LOG_ERROR("Unknown log level: %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--logbin") == 0 && i + 1 < argc) {
+            config.logfile = argv[++i];
+        } else if (strcmp(argv[i], "--rewind") == 0 && i + 1 < argc) {
+            config.rewind = (uint)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--scores") == 0 && i + 1 < argc) {
+            config.scorefile = argv[++i];
+        } else if (strcmp(argv[i], "--noscores") == 0) {
+            config.scorefile = NULL;
+        } else if (strcmp(argv[i], "--noidle") == 0) {
+            config.idle = false;
+        } else if (strcmp(argv[i], "--novsync") == 0) {
+            config.vsync = false;
+        } else if (strcmp(argv[i], "--drawstats") == 0) {
+            config.drawstats = true;
+        } else if (strcmp(argv[i], "--startupstats") == 0) {
+            config.startupstats = true;
+        } else {
+            LOG_ERROR("Unknown option: %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Plays every --verify replay headless at full speed and reports the ones
+// whose score or death tick came out different. A file may hold several
+// replays one after another, like the archive next to the high scores.
+static int G_VerifyReplays(void) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 ticks = 0;
+    int replays = 0, failed = 0;
+    for (int i = 0; i < config.numverify; i++) {
+        const char *path = config.verifyfiles[i];
+        FILE *handle = fopen(path, "rb");
+        Replay check;
+        int count = 0;
+        while (handle != NULL && S_ReplayRead(&check, handle)) {
+            int score;
+            uint deathtick;
+            if (!S_ReplayVerify(&check, &score, &deathtick)) {
+                printf("%s #%d: MISMATCH score %d tick %u, "
+                       "recorded score %d tick %u\n", path, count, score,
+                       deathtick, check.score, check.deathtick);
+                failed++;
+            }
+            ticks += deathtick;
+            count++;
+            S_ReplayFree(&check);
+        }
+        // A clean end of file after the last replay, anything else is damage
+        if (handle == NULL || count == 0 || !feof(handle)) {
+            LOG_ERROR("Could not load replay: %s\n", path);
+            failed++;
+        }
+        if (handle != NULL)
+            fclose(handle);
+        replays += count;
+    }
+    const double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 /
+        SDL_GetPerformanceFrequency();
+    printf("%d replays, %d failed, %llu ticks in %.2f ms\n", replays,
+           failed, (unsigned long long)ticks, ms);
+    return failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Replays recorded at another tick rate are left out, they would drift.
+static boolean G_LoadGhosts(void) {
+    const uint capacity = config.bench == BENCH_GHOSTS ?
+        BENCH_NUM_GHOSTS : (uint)config.numghosts;
+    if (!S_GhostCreate(&ghosts, capacity, sim.tickrate) ||
+        !R_GhostInit(capacity)) {
+        LOG_ERROR("Not enough memory for %u ghosts\n", capacity);
+        return false;
+    }
+    if (config.bench == BENCH_GHOSTS) {
+        G_MakeBenchGhosts();
+        return true;
+    }
+    for (int i = 0; i < config.numghosts; i++) {
+        const char *path = config.ghostfiles[i];
+        if (ghosts.count == ghosts.capacity) {
+            LOG_WARNING("Room for %u ghosts, %d more left out\n",
+                        ghosts.capacity, config.numghosts - i);
+            break;
+        }
+        Replay ghost;
+        if (!S_ReplayLoad(&ghost, path)) {
+            LOG_WARNING("Could not load ghost: %s\n", path);
+            continue;
+        }
+        if (ghost.tickrate != ghosts.tickrate) {
+            LOG_WARNING("Ghost %s is at %u ticks per second, not %u\n", path,
+                        ghost.tickrate, ghosts.tickrate);
+        } else if (!S_GhostAddReplay(&ghosts, &ghost)) {
+            LOG_WARNING("Not enough memory for ghost: %s\n", path);
+        }
+        S_ReplayFree(&ghost);
+    }
+    LOG_MESSAGE("Racing %u ghosts\n", ghosts.count);
+    return true;
+}
+
+// Birds flapping about every SIM_FLAP_HEIGHT pixels fallen, give or take,
+// for as long as the benchmark runs.
+static void G_MakeBenchGhosts(void) {
+    const uint numticks = (uint)(config.benchframes * BENCH_FRAME_MS *
+                                 sim.tickrate / 1000.0) + 1;
+    const uint interval = (uint)(SIM_FLAP_HEIGHT * SIM_SPEED_MS *
+                                 sim.tickrate / 1000);
+    Uint32 *ticks = malloc((numticks / (interval / 2 + 1) + 1) *
+                           sizeof(Uint32));
+    if (ticks == NULL)
+        return;
+    RandomState rng;
+    U_RandomSeed(&rng, BENCH_SEED, 0);
+    for (uint i = 0; i < BENCH_NUM_GHOSTS; i++) {
+        uint numflaps = 0;
+        uint tick = (uint)U_RandomRange(&rng, 1, (int)interval);
+        while (tick <= numticks) {
+            ticks[numflaps++] = tick;
+            tick += (uint)U_RandomRange(&rng, (int)(interval / 2 + 1),
+                                        (int)(interval * 3 / 2));
+        }
+        S_GhostAdd(&ghosts, ticks, numflaps, numticks);
+    }
+    free(ticks);
+}
+
 static void G_AppendAssetPath(char *path) {
 	char cpystr[256];
 	strcpy(cpystr, path);
@@ -202,67 +889,289 @@ static void G_AppendAssetPath(char *path) {
 	strcat(path, cpystr);
 }
 
-static boolean G_LoadAssets(SDL_Renderer *renderer) {
-    pipetexture = IMG_LoadTexture(renderer, ASSETS_DIR"pipe.webp");
-    if (pipetexture == NULL) {
-        LOG_ERROR("Image could not be found: %s\n", SDL_GetError());
-        return false;
+// Runs on the loader thread. All file I/O and decoding happens here, the
+// results are published a stage at a time through loader.stage and only the
+// texture uploads are left to G_PollAssets() on the render thread.
+static int G_LoadWorker(void *data) {
+    if (G_OpenPak()) {
+        loader.usepak = true;
+        // Fault the mapping in here instead of during the upload
+        volatile Uint8 touched = 0;
+        for (size_t i = 0; i < pak.size; i += 4096) {
+            touched += pak.data[i];
+        }
+        (void)touched;
+    } else {
+        LOG_MESSAGE("No usable asset bundle, loading loose files\n");
+        for (uint i = 0; i < NUM_SPRITES; i++) {
+            char path[256];
+            strcpy(path, spritefiles[i]);
+            G_AppendAssetPath(path);
+            loader.sprites[i] = IMG_Load(path);
+            if (loader.sprites[i] == NULL) {
+                LOG_ERROR("Image could not be found: %s\n", SDL_GetError());
+                return G_LoadFailed();
+            }
+        }
     }
-    birdtexture = IMG_LoadTexture(renderer, ASSETS_DIR"birbTile.webp");
-    if (birdtexture == NULL) {
-        LOG_ERROR("Image could not be found: %s\n", SDL_GetError());
-        return false;
+    loader.icon = IMG_Load(ASSETS_DIR"birb0.webp");
+    if (loader.icon == NULL) {
+        LOG_ERROR("SDL Icon failed to load: %s\n", SDL_GetError());
+        return G_LoadFailed();
+    }
+    G_LoadPublish(LOAD_SPRITES);
+
+    if (loader.usepak) {
+        const PakEntry *entry = A_PakFind(&pak, "FlappyBirdy.ttf", PAK_FILE);
+        SDL_RWops *rw = SDL_RWFromConstMem(A_PakData(&pak, entry),
+                                           (int)entry->length);
+        loader.font = TTF_OpenFontRW(rw, 1, FONT_SIZE);
+    } else {
+        loader.font = TTF_OpenFont(ASSETS_DIR"FlappyBirdy.ttf", FONT_SIZE);
+    }
+    if (loader.font == NULL) {
+        LOG_ERROR("Font failed to load: %s\n", SDL_GetError());
+        return G_LoadFailed();
+    }
+    const SDL_Color textcolor = { 0, 0, 0, 255 };
+    const SDL_Color textcolor2 = { 255, 255, 255, 255 };
+    loader.text = TTF_RenderText_Blended_Wrapped(loader.font,
+                                                 "Press Space to Start",
+                                                 textcolor, TEXT_WRAP);
+    loader.textover = TTF_RenderText_Blended_Wrapped(loader.font,
+                                                     "Press Space to Restart",
+                                                     textcolor2, TEXT_WRAP);
+    if (loader.text == NULL || loader.textover == NULL ||
+        !R_HudBuild(loader.font, textcolor2)) {
+        LOG_ERROR("Text rendering failed: %s!\n", TTF_GetError());
+        return G_LoadFailed();
+    }
+    G_LoadPublish(LOAD_TEXT);
+
+    for (uint i = 0; i < NUM_SOUNDS; i++) {
+        if (!G_LoadSound(i))
+            return G_LoadFailed();
     }
-    SDL_QueryTexture(birdtexture, NULL, NULL, &birdanim.w, &birdanim.h);
+    G_LoadPublish(LOAD_SOUNDS);
+    return 0;
+}
+
+static void G_LoadPublish(int stage) {
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&loader.stage, stage);
+}
+
+static int G_LoadFailed(void) {
+    G_LoadPublish(LOAD_FAILED);
+    return -1;
+}
 
-    bgtexture = IMG_LoadTexture(renderer, ASSETS_DIR"bgTex.webp");
-    if (bgtexture == NULL) {
-        LOG_ERROR("Image could not be found: %s\n", SDL_GetError());
+static boolean G_StartLoading(void) {
+    SDL_AtomicSet(&loader.stage, LOAD_NONE);
+    loader.thread = SDL_CreateThread(G_LoadWorker, "AssetLoader", NULL);
+    if (loader.thread == NULL) {
+        LOG_ERROR("Loader thread creation failed: %s\n", SDL_GetError());
         return false;
     }
-    groundtexture = IMG_LoadTexture(renderer, ASSETS_DIR"ground.webp");
-    if (groundtexture == NULL) {
-        LOG_ERROR("Image could not be found: %s\n", SDL_GetError());
+    return true;
+}
+
+// Takes over whatever the loader thread finished since the last call.
+static boolean G_PollAssets(SDL_Window *window, SDL_Renderer *renderer) {
+    if (assetsready)
+        return true;
+    const int stage = SDL_AtomicGet(&loader.stage);
+    SDL_MemoryBarrierAcquire();
+    if (stage == LOAD_FAILED) {
+        SDL_WaitThread(loader.thread, NULL);
+        loader.thread = NULL;
         return false;
     }
-	font = TTF_OpenFont(ASSETS_DIR"FlappyBirdy.ttf", 22);
-    if (font == NULL) {
-        LOG_ERROR("Font failed to load: %s\n", SDL_GetError());
+    while (loadedstage < stage) {
+        loadedstage++;
+        switch (loadedstage) {
+        case LOAD_SPRITES:
+            if (!G_UploadSprites(window, renderer))
+                return false;
+            break;
+        case LOAD_TEXT:
+            font = loader.font;
+            G_SetupFont(renderer);
+            if (!R_HudUpload(renderer)) {
+                LOG_ERROR("Score glyph upload failed: %s\n", SDL_GetError());
+                return false;
+            }
+            break;
+        case LOAD_SOUNDS:
+            for (uint i = 0; i < NUM_SOUNDS; i++) {
+                sounds[i] = loader.sounds[i];
+                mixsounds[i] = loader.mixsounds[i];
+            }
+            SDL_WaitThread(loader.thread, NULL);
+            loader.thread = NULL;
+            assetsready = true;
+            break;
+        }
+    }
+    return true;
+}
+
+// The SDL_mixer path keeps the original buffer unless --audiobuffer is
+// given. --lowlatency mixes in its own callback with a much smaller one.
+static boolean G_OpenAudio(void) {
+    if (config.lowlatency) {
+        const int samples = config.audiobuffer > 0 ?
+            config.audiobuffer : AUDIO_BUFFER_LOW;
+        return A_MixOpen(AUDIO_FREQ, MIX_DEFAULT_FORMAT, 2, samples);
+    }
+    const int samples = config.audiobuffer > 0 ?
+        config.audiobuffer : AUDIO_BUFFER;
+    Mix_OpenAudio(AUDIO_FREQ, MIX_DEFAULT_FORMAT, 2, samples); // SDL_mixer
+    Mix_Volume(-1, 5);
+    return true;
+}
+
+// Uses the bundle only if it has every asset and its sounds are already in
+// the format the mixer was opened with.
+static boolean G_OpenPak(void) {
+    int freq, channels, samples;
+    Uint16 format;
+    boolean opened;
+
+    if (!A_PakOpen(&pak, ASSETS_DIR PAK_FILENAME))
         return false;
+    if (config.lowlatency) {
+        A_MixSpec(&freq, &format, &channels, &samples);
+        opened = A_MixIsOpen();
+    } else {
+        opened = Mix_QuerySpec(&freq, &format, &channels) != 0;
+    }
+    boolean usable = opened &&
+        (Uint32)freq == pak.header->audiofreq &&
+        format == pak.header->audioformat &&
+        channels == pak.header->audiochannels &&
+        A_PakFind(&pak, "FlappyBirdy.ttf", PAK_FILE) != NULL;
+    for (uint i = 0; usable && i < NUM_SPRITES; i++) {
+        usable = A_PakFind(&pak, spritefiles[i], PAK_SPRITE) != NULL;
+    }
+    for (uint i = 0; usable && i < NUM_SOUNDS; i++) {
+        usable = A_PakFind(&pak, soundfiles[i], PAK_SOUND) != NULL;
+    }
+    if (!usable) {
+        A_PakClose(&pak);
+    }
+    return usable;
+}
+
+// Fills loader.sounds, or loader.mixsounds with --lowlatency. Loose wavs
+// are converted to the device format here so playing them costs nothing.
+static boolean G_LoadSound(uint sound) {
+    if (config.lowlatency) {
+        if (loader.usepak) {
+            const PakEntry *entry =
+                A_PakFind(&pak, soundfiles[sound], PAK_SOUND);
+            A_MixBorrow(&loader.mixsounds[sound], A_PakData(&pak, entry),
+                        entry->length);
+            return true;
+        }
+        char path[256];
+        strcpy(path, soundfiles[sound]);
+        G_AppendAssetPath(path);
+        if (!A_MixLoadWAV(&loader.mixsounds[sound], path)) {
+            LOG_ERROR("Sound failed to load: %s\n", SDL_GetError());
+            return false;
+        }
+        return true;
+    }
+    if (loader.usepak) {
+        loader.sounds[sound] = G_PakSound(soundfiles[sound]);
+    } else {
+        char path[256];
+        strcpy(path, soundfiles[sound]);
+        G_AppendAssetPath(path);
+        loader.sounds[sound] = Mix_LoadWAV(path);
+    }
+    return loader.sounds[sound] != NULL;
+}
+
+static Mix_Chunk *G_PakSound(const char *name) {
+    const PakEntry *entry = A_PakFind(&pak, name, PAK_SOUND);
+    // Plays straight from the mapping, Mix_FreeChunk() won't free it
+    return Mix_QuickLoad_RAW((Uint8 *)A_PakData(&pak, entry), entry->length);
+}
+
+// The bundle's atlas is uploaded as is, loose sprites were decoded by the
+// loader thread. Either way this is the only part that needs the renderer.
+static boolean G_UploadSprites(SDL_Window *window, SDL_Renderer *renderer) {
+    SDL_Texture **textures[NUM_SPRITES] = {
+        &pipetexture, &birdtexture, &bgtexture, &groundtexture,
+    };
+    SDL_Rect *srcs[NUM_SPRITES] = { &pipesrc, &birdsrc, &bgsrc, &groundsrc };
+
+    if (loader.usepak) {
+        const PakHeader *header = pak.header;
+        atlastexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                         SDL_TEXTUREACCESS_STATIC,
+                                         (int)header->atlaswidth,
+                                         (int)header->atlasheight);
+        if (atlastexture == NULL) {
+            LOG_ERROR("Atlas texture creation failed: %s\n", SDL_GetError());
+            return false;
+        }
+        SDL_UpdateTexture(atlastexture, NULL, A_PakAtlas(&pak),
+                          (int)header->atlaswidth * 4);
+        SDL_SetTextureBlendMode(atlastexture, SDL_BLENDMODE_BLEND);
+    }
+    for (uint i = 0; i < NUM_SPRITES; i++) {
+        if (loader.usepak) {
+            const PakEntry *entry = A_PakFind(&pak, spritefiles[i], PAK_SPRITE);
+            *textures[i] = atlastexture;
+            srcs[i]->x = (int)entry->x;
+            srcs[i]->y = (int)entry->y;
+            srcs[i]->w = (int)entry->w;
+            srcs[i]->h = (int)entry->h;
+        } else {
+            *textures[i] = SDL_CreateTextureFromSurface(renderer,
+                                                        loader.sprites[i]);
+            SDL_FreeSurface(loader.sprites[i]);
+            loader.sprites[i] = NULL;
+            if (*textures[i] == NULL) {
+                LOG_ERROR("Texture creation failed: %s\n", SDL_GetError());
+                return false;
+            }
+            srcs[i]->x = srcs[i]->y = 0;
+            SDL_QueryTexture(*textures[i], NULL, NULL, &srcs[i]->w,
+                             &srcs[i]->h);
+        }
+    }
+    birdanim.w = birdsrc.w;
+    birdanim.h = birdsrc.h;
+    for (uint i = 0; i < SIZEOF_ARRAY(birdframes); i++) {
+        const uint frame = i < NUM_FRAMES + 1 ? i : NUM_FRAMES;
+        birdframes[i].x = birdsrc.x + (int)frame * BIRD_FRAME_W;
+        birdframes[i].y = birdsrc.y;
+        birdframes[i].w = BIRD_FRAME_W;
+        birdframes[i].h = BIRD_FRAME_H;
     }
-	if (!G_SetupFont(renderer)) {
-		LOG_ERROR("G_SetupFont(): failed: %s!\n", TTF_GetError());
-	}
-    flapsound = Mix_LoadWAV(ASSETS_DIR"flap.wav");
-    if (flapsound == NULL) return false;
-    scoresound = Mix_LoadWAV(ASSETS_DIR"score.wav");
-    if (scoresound == NULL) return false;
-    losesound = Mix_LoadWAV(ASSETS_DIR"lose.wav");
-    if (losesound == NULL) return false;
+    SDL_SetWindowIcon(window, loader.icon);
+    SDL_FreeSurface(loader.icon);
+    loader.icon = NULL;
     return true;
 }
 
 static boolean G_SetupFont(SDL_Renderer *renderer) {
-    const SDL_Color textcolor = { 0, 0, 0, 255 };
-    const SDL_Color textcolor2 = { 255, 255, 255, 255 };
-    textsurface = TTF_RenderText_Blended_Wrapped(font, "Press Space to Start",
-												 textcolor, 60);
-    texttexture = SDL_CreateTextureFromSurface(renderer, textsurface);
-    SDL_FreeSurface(textsurface);
+    texttexture = SDL_CreateTextureFromSurface(renderer, loader.text);
+    SDL_FreeSurface(loader.text);
+    loader.text = NULL;
     SDL_QueryTexture(texttexture, NULL, NULL, &textrect.w, &textrect.h);
-    textrect.w *= 4;
-    textrect.h *= 4;
     textrect.x = 200 - (textrect.w / 2);
     textrect.y = 125 - (textrect.h /2);
     // printf("Text 1, Width: %d, Height: %d\n", textrect.w, textrect.h);
-    textsurface = TTF_RenderText_Blended_Wrapped(font, "Press Space to Restart",
-												 textcolor2, 60);
-    textovertexture = SDL_CreateTextureFromSurface(renderer, textsurface);
-    SDL_FreeSurface(textsurface);
+    textovertexture = SDL_CreateTextureFromSurface(renderer, loader.textover);
+    SDL_FreeSurface(loader.textover);
+    loader.textover = NULL;
     SDL_QueryTexture(textovertexture, NULL, NULL, &textoverrect.w,
 					 &textoverrect.h);
-    textoverrect.w *= 4;
-    textoverrect.h *= 4;
     textoverrect.x = width / 2 - (textoverrect.w / 2);
     textoverrect.y = height / 2 - (textoverrect.h / 2);
     // printf("Text 2, Width: %d, Height: %d\n", textrect.w, textrect.h);
@@ -270,211 +1179,338 @@ static boolean G_SetupFont(SDL_Renderer *renderer) {
 }
 
 static void G_FreeAssets(void) {
-    SDL_DestroyTexture(pipetexture);
-    SDL_DestroyTexture(birdtexture);
-    SDL_DestroyTexture(bgtexture);
-    SDL_DestroyTexture(groundtexture);
+    if (atlastexture != NULL) {
+        SDL_DestroyTexture(atlastexture);
+    } else {
+        SDL_DestroyTexture(pipetexture);
+        SDL_DestroyTexture(birdtexture);
+        SDL_DestroyTexture(bgtexture);
+        SDL_DestroyTexture(groundtexture);
+    }
     IMG_Quit();
     TTF_Quit();
-    Mix_FreeChunk(flapsound);
-    Mix_FreeChunk(scoresound);
-    Mix_FreeChunk(losesound);
-    Mix_CloseAudio();
+    if (config.lowlatency) {
+        A_MixClose(); // before the sounds it may still be playing
+        for (uint i = 0; i < NUM_SOUNDS; i++) {
+            A_MixFree(&mixsounds[i]);
+        }
+    } else {
+        for (uint i = 0; i < NUM_SOUNDS; i++) {
+            Mix_FreeChunk(sounds[i]);
+        }
+        Mix_CloseAudio();
+    }
     Mix_Quit();
+    A_PakClose(&pak);
 }
 
-static void P_Start(SDL_Renderer *renderer) {
-    if (spacedown) {
-        if (birdhascollided) {
-            loseplayedonce = false;
-            state = STATE_PLAY;
-            birdhascollided = false;
-            score = 0;
-        } else
-            state++;
-        spacedown = false;
+static void P_HandleEvents(SDL_Window *window, uint events) {
+    const Uint64 now = SDL_GetPerformanceCounter();
+    if (events & SIM_EVENT_FLAP) {
+        P_PlaySound(SOUND_FLAP, spacestamp);
     }
-
-    SDL_SetRenderDrawColor(renderer, 0, 255/2, 255, 255);
-    SDL_RenderClear(renderer);
-    R_DrawBackground(&bgrect, renderer);
-    R_DrawBird(&bird, &birdanim, renderer);
-    R_DrawGround(&groundrect, renderer, 0);
-    SDL_RenderCopy(renderer, texttexture, NULL, &textrect);
-    for (uint i = 0; i < NUM_PIPES; i++) {
-        R_DrawPipe(&pipes[i], &bird, renderer);
+    if (events & SIM_EVENT_SCORE) {
+        P_PlaySound(SOUND_SCORE, now);
     }
-    if (bird.x > pipes[NUM_PIPES - 2].x) {
-        P_GeneratePipes();
+    if (events & SIM_EVENT_DEATH) {
+        P_PlaySound(SOUND_LOSE, now);
+        P_UpdateScore(window); // once per run, not per frame
     }
 }
 
-static void P_Play(SDL_Window *window, SDL_Renderer *renderer, double dt) {
-    if (spacedown) {
-        if (!birdhascollided) {
-            Mix_PlayChannel(-1, flapsound, 0);
-            bird.y -= 50;
+// stamp is when whatever caused the sound happened, for --audiostats.
+static void P_PlaySound(uint sound, Uint64 stamp) {
+    if (config.lowlatency) {
+        A_MixPlay(&mixsounds[sound], stamp);
+    } else if (sounds[sound] != NULL) {
+        Mix_PlayChannel(-1, sounds[sound], 0);
+    }
+}
+
+// Records the run for --record and the high scores, or checks the result
+// of a --play replay.
+static void P_ReplayEvents(uint events) {
+    if (config.playfile != NULL) {
+        if (events & SIM_EVENT_DEATH) {
+            const boolean match = sim.score == replay.score &&
+                sim.tick == replay.deathtick;
+            printf("replay %s: score %d tick %u\n",
+                   match ? "matches" : "MISMATCH", sim.score, sim.tick);
+        }
+        return;
+    }
+    if (config.recordfile == NULL && !S_ScoreIsOpen())
+        return;
+    if (events & SIM_EVENT_START) {
+        S_ReplayBegin(&replay, &sim);
+        rewound = false;
+    }
+    if (events & (SIM_EVENT_START | SIM_EVENT_FLAP)) {
+        if (!S_ReplayFlap(&replay, sim.tick)) {
+            LOG_ERROR("Out of memory recording the replay\n");
+        }
+    }
+    if (events & SIM_EVENT_DEATH) {
+        S_ReplayEnd(&replay, &sim);
+        if (config.recordfile != NULL &&
+            !S_ReplaySave(&replay, config.recordfile)) {
+            LOG_ERROR("Could not save replay: %s\n", config.recordfile);
+        }
+        if (S_ScoreIsOpen() && !rewound && !S_ScoreAdd(&sim, &replay)) {
+            LOG_WARNING("High score writer behind, run dropped\n");
         }
-        spacedown = false;
     }
+}
+
+static void P_Start(SDL_Renderer *renderer) {
     SDL_SetRenderDrawColor(renderer, 0, 255/2, 255, 255);
     SDL_RenderClear(renderer);
     R_DrawBackground(&bgrect, renderer);
-    bird.y += 1 * (int)dt / 6;
-    R_DrawBird(&bird, &birdanim, renderer);
-    R_DrawGround(&groundrect, renderer, dt);
-    for (size_t i = 0; i < NUM_PIPES; i++) {
-        pipes[i].x -= 1 * (int)dt / 6;
-        R_DrawPipe(&pipes[i], &bird, renderer);
+    R_DrawBird(&view.bird, &birdanim, renderer);
+    R_DrawGround(&groundrect, renderer);
+    R_BatchQuad(texttexture, NULL, &textrect, SDL_FLIP_NONE);
+    for (uint i = 0; i < SIM_NUM_PIPES; i++) {
+        R_DrawPipe(&view.pipes[i], renderer);
     }
-    if (bird.x > pipes[NUM_PIPES - 2].x) {
-        P_GeneratePipes();
+}
+
+static void P_Play(SDL_Renderer *renderer) {
+    SDL_SetRenderDrawColor(renderer, 0, 255/2, 255, 255);
+    SDL_RenderClear(renderer);
+    R_DrawBackground(&bgrect, renderer);
+    R_DrawGhosts(renderer);
+    R_DrawBird(&view.bird, &birdanim, renderer);
+    R_DrawGround(&groundrect, renderer);
+    for (uint i = 0; i < SIM_NUM_PIPES; i++) {
+        R_DrawPipe(&view.pipes[i], renderer);
     }
-	P_UpdateScore(window);
+    U_ProfBegin(PHASE_HUD);
+    R_HudDraw(view.score, width / 2, HUD_Y);
+    U_ProfEnd(PHASE_HUD);
 }
 
 static void P_Over(SDL_Renderer *renderer) {
-    if (spacedown) {
-        P_ResetPlayerPos();
-        P_GeneratePipes();
-        state = STATE_START;
-        spacedown = false;
-    }
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, textovertexture, NULL, &textoverrect);
-    if (!loseplayedonce) {
-        Mix_PlayChannel(-1, losesound, 0);
-        loseplayedonce = true;
+    R_BatchQuad(textovertexture, NULL, &textoverrect, SDL_FLIP_NONE);
+    if (!S_ScoreIsOpen())
+        return;
+    // The run's score on top, the best ones stored along the bottom
+    U_ProfBegin(PHASE_HUD);
+    R_HudDraw(sim.score, width / 2, HUD_Y);
+    ScoreRecord best[SCORE_TOP];
+    const uint count = S_ScoreTop(best, SCORE_TOP);
+    for (uint i = 0; i < count; i++) {
+        const int centerx = (int)(width * (2 * i + 1) / (2 * SCORE_TOP));
+        R_HudDrawSized(best[i].score, centerx, BOARD_Y, BOARD_HEIGHT);
     }
-
+    U_ProfEnd(PHASE_HUD);
 }
 
 static void R_DrawBackground(SDL_Rect *rect, SDL_Renderer *renderer) {
+    U_ProfBegin(PHASE_BACKGROUND);
     rect->x = 0;
     rect->y = 0;
     rect->w = width;
     rect->h = height;
-    SDL_RenderCopy(renderer, bgtexture, NULL, rect);
+    R_BatchQuad(bgtexture, &bgsrc, rect, SDL_FLIP_NONE);
+    U_ProfEnd(PHASE_BACKGROUND);
 }
 
 static void R_DrawBird(SDL_Rect *rectbird, SDL_Rect *rectanim,
 					   SDL_Renderer *renderer) {
-    if (rectbird->y >= height - (birdsize / 2)) {
-        rectbird->y = height - (birdsize / 2);
-    }
+    U_ProfBegin(PHASE_BIRD);
     // animate(rectanim, 100, 3);
     /* if (fps >= 30) {
         curframe++;
         fps = 0;
     } */
     curframe = (SDL_GetTicks() / speed) & NUM_FRAMES + 1;
-    switch(curframe)
-    {
-    case 0:
-        rectanim->x = 0;
-        rectanim->y = 0;
-        rectanim->w = 65;
-        rectanim->h = 68;
-        break;
-    case 1:
-        rectanim->x = 65;
-        rectanim->y = 0;
-        rectanim->w = 65;
-        rectanim->h = 68;
-        break;
-    case 2:
-        rectanim->x = 65 + 65;
-        rectanim->y = 0;
-        rectanim->w = 65;
-        rectanim->h = 68;
-        break;
-    case 3:
-        //curframe = 0;
-        break;
-    }
-    SDL_RenderCopy(renderer, birdtexture, rectanim, rectbird);
-}
-
-static void R_DrawGround(SDL_Rect *rect, SDL_Renderer *renderer, double dt) {
-    const int minx = width - (width * 2);
-    if (rect->x <= minx) {
-        rect->x = 0;
-    }
-    else {
-        rect->x -= 1 * (int)dt / 6;
-    }
+    *rectanim = birdframes[curframe];
+    R_BatchQuad(birdtexture, rectanim, rectbird, SDL_FLIP_NONE);
+    U_ProfEnd(PHASE_BIRD);
+}
+
+// Behind the player, and only once the ghosts are on the player's tick.
+static void R_DrawGhosts(SDL_Renderer *renderer) {
+    if (ghosts.count == 0 || ghosts.tick != sim.tick)
+        return;
+    U_ProfBegin(PHASE_BIRD);
+    R_GhostDraw(renderer, birdtexture, birdframes, SIZEOF_ARRAY(birdframes),
+                SDL_GetTicks() / (Uint32)speed, &ghosts, SIM_BIRD_X,
+                SIM_BIRD_SIZE);
+    U_ProfEnd(PHASE_BIRD);
+}
+
+static void R_DrawGround(SDL_Rect *rect, SDL_Renderer *renderer) {
+    U_ProfBegin(PHASE_GROUND);
+    rect->x = view.groundx;
     rect->y = 0;
     rect->w = width * 2;
     rect->h = height;
-    SDL_RenderCopy(renderer, groundtexture, NULL, rect);
+    R_BatchQuad(groundtexture, &groundsrc, rect, SDL_FLIP_NONE);
+    U_ProfEnd(PHASE_GROUND);
 }
 
-static void R_DrawPipe(SDL_Rect *rect, SDL_Rect *rectbird,
-					   SDL_Renderer *renderer) {
+static void R_DrawPipe(SDL_Rect *rect, SDL_Renderer *renderer) {
     SDL_Rect toprect;
     SDL_Rect middlerect;
     SDL_Rect bottomrect;
 
-    toprect.x = rect->x;
-    toprect.y = rect->y - pipeheight - lengthinbetween;
-    toprect.w = pipewidth;
-    toprect.h = pipeheight;
-
-    bottomrect.x = rect->x;
-    bottomrect.y = rect->y + lengthinbetween;
-    bottomrect.w = pipewidth;
-    bottomrect.h = pipeheight;
-
-    middlerect.x = rect->x + (pipewidth/2);
-    middlerect.y = bottomrect.y - (lengthinbetween * 2);
-    middlerect.w = 3;
-    middlerect.h = lengthinbetween * 2;
-
-    if (U_IsColliding(rectbird, &toprect) || U_IsColliding(rectbird,
-														   &bottomrect)) {
-        state = STATE_OVER;
-        birdhascollided = true;
-    }
-    if (U_IsColliding(rectbird, &middlerect) && !hasscored &&
-		rectbird->x > middlerect.x) {
-        // I don't know why this works but it does
-        Mix_PlayChannel(-1, scoresound, 0);
-        score += 1;
-        hasscored = true;
-    } else {
-        hasscored = false;
+    U_ProfBegin(PHASE_PIPES);
+    S_PipeRects(rect, &toprect, &bottomrect, &middlerect);
+    R_BatchQuad(pipetexture, &pipesrc, &toprect, SDL_FLIP_VERTICAL);
+    R_BatchQuad(pipetexture, &pipesrc, &bottomrect, SDL_FLIP_NONE);
+    U_ProfEnd(PHASE_PIPES);
+}
+
+static void P_UpdateScore(SDL_Window *window) {
+    static char scorestr[32];
+    snprintf(scorestr, sizeof(scorestr), "%d", sim.score);
+    strcpy(title, "Flappy Birby, Score: ");
+    strcat(title, scorestr);
+    SDL_SetWindowTitle(window, title);
+}
+
+
+// Averages the sprite batch counters and prints them once a second.
+static void P_PrintDrawStats(const RenderStats *stats) {
+    static RenderStats total;
+    static uint frames = 0;
+    static Uint32 last = 0;
+    total.drawcalls += stats->drawcalls;
+    total.quads += stats->quads;
+    total.culled += stats->culled;
+    frames++;
+    const Uint32 now = SDL_GetTicks();
+    if (now - last >= 1000) {
+        printf("frames: %u, draw calls/frame: %.1f, quads/frame: %.1f, "
+               "culled/frame: %.1f, scale: %.3f\n", frames,
+               (double)total.drawcalls / frames, (double)total.quads / frames,
+               (double)total.culled / frames, R_ScaleGet());
+        total.drawcalls = total.quads = total.culled = 0;
+        frames = 0;
+        last = now;
     }
-    const SDL_RendererFlip flip = SDL_FLIP_VERTICAL;
-    SDL_RenderCopyEx(renderer, pipetexture, NULL, &toprect, 0, NULL, flip);
-    SDL_RenderCopy(renderer, pipetexture, NULL, &bottomrect);
 }
 
-static void P_ResetPlayerPos(void) {
-    bird.x = 100;
-    bird.y = 250;
-    bird.w = birdsize;
-    bird.h = birdsize;
+// Writes path.json (Chrome trace) and path.csv from the profiler ring.
+static void P_WriteProfile(const char *path) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "%s.json", path);
+    if (!U_ProfWriteTrace(filename)) {
+        LOG_ERROR("Could not write profile: %s\n", filename);
+    }
+    snprintf(filename, sizeof(filename), "%s.csv", path);
+    if (!U_ProfWriteCsv(filename)) {
+        LOG_ERROR("Could not write profile: %s\n", filename);
+    }
 }
 
-static void P_GeneratePipes(void) {
-    for (uint i = 0; i < NUM_PIPES; i++) {
-        if (i > 0) {
-            pipes[i].x = pipes[i-1].x + 350;
-        } else {
-            pipes[0].x = 350;
+static boolean P_BenchInput(void) {
+    switch (config.bench) {
+    case BENCH_PLAY:
+    case BENCH_GHOSTS:
+        if (sim.state != STATE_PLAY)
+            return true;
+        for (uint k = 0; k < SIM_NUM_PIPES; k++) {
+            const SDL_Rect *pipe =
+                &sim.pipes[(sim.headpipe + k) % SIM_NUM_PIPES];
+            if (pipe->x + SIM_PIPE_WIDTH > sim.bird.x) {
+                // Flap once the bird sinks near the bottom of the gap, but
+                // not on every tick or it overshoots the top
+                return sim.bird.y + SIM_BIRD_SIZE + 10 > pipe->y + pipe->h &&
+                    sim.tick % 4 == 0;
+            }
         }
-        pipes[i].y = U_RandomNum(height / 2 - lengthinbetween,
-								 height / 2 + lengthinbetween) + 200;
-        //printf("Pipe at %d, Y: %d\n", i + 1, pipes[i].y);
+        return false;
+    case BENCH_RESTART:
+        return sim.state != STATE_PLAY;
+    default:
+        return false;
     }
 }
 
-static void P_UpdateScore(SDL_Window *window) {
-    static char scorestr[32];
-    snprintf(scorestr, sizeof(scorestr), "%d", score);
-    strcpy(title, "Flappy Birby, Score: ");
-    strcat(title, scorestr);
-    SDL_SetWindowTitle(window, title);
+// One line per phase so the output of two commits can be diffed.
+static void P_PrintBench(uint frames, double seconds) {
+    ProfStats stats[NUM_PHASES + 1];
+    U_ProfStats(stats, frames);
+    printf("bench %s: %u frames in %.3f s, %.1f fps\n",
+           benchnames[config.bench], frames, seconds, frames / seconds);
+    printf("%-10s %9s %9s %9s %9s\n", "ms", "min", "avg", "p50", "p99");
+    for (uint p = 0; p <= NUM_PHASES; p++) {
+        printf("%-10s %9.4f %9.4f %9.4f %9.4f\n",
+               p < NUM_PHASES ? phasenames[p] : "frame",
+               stats[p].min, stats[p].avg, stats[p].p50, stats[p].p99);
+    }
 }
 
+// Latency from the input (or sim event) to the callback picking the sound
+// up, i.e. the earliest its samples can be in the device buffer.
+static void P_PrintAudioStats(void) {
+    MixStats stats;
+    int freq, channels, samples;
+    Uint16 format;
+    A_MixGetStats(&stats);
+    A_MixSpec(&freq, &format, &channels, &samples);
+    printf("audio: %d Hz, %d frame buffer (%.1f ms)\n", freq, samples,
+           freq > 0 ? samples * 1000.0 / freq : 0.0);
+    printf("audio: %u sounds, %u voices stolen, latency ms min %.2f "
+           "avg %.2f max %.2f\n", stats.played, stats.stolen, stats.minms,
+           stats.avgms, stats.maxms);
+}
+
+// From the key press (its event timestamp) to SDL_RenderPresent() returning
+// on the first frame drawn after the flap it caused. The ms resolution of
+// the timestamps is the best SDL gives us.
+static void P_PrintInputStats(void) {
+    if (numpresses == 0) {
+        printf("input to present: no presses\n");
+        return;
+    }
+    printf("input to present: %u presses, ms min %u avg %.1f max %u\n",
+           numpresses, pressmin, presstotal / (double)numpresses, pressmax);
+}
+
+// Restarts on its own a while after dying, so it can run unattended.
+static boolean P_AutoInput(void) {
+    if (sim.state == STATE_OVER) {
+        if (autoover == 0) {
+            autoover = SDL_GetTicks();
+        }
+        if (SDL_GetTicks() - autoover < AUTO_RESTART_MS)
+            return false;
+        autoover = 0;
+        return true;
+    }
+    return S_AutoFlap(&autopilot, &sim);
+}
+
+static void P_PrintAutoStats(void) {
+    const AutoStats *stats = &autopilot.stats;
+    if (stats->decisions == 0) {
+        printf("autopilot: no decisions\n");
+        return;
+    }
+    printf("autopilot: %u decisions, %u over budget, %.0f nodes/s, "
+           "ms min %.3f avg %.3f max %.3f\n", stats->decisions,
+           stats->timeouts, stats->nodes / stats->seconds, stats->minms,
+           stats->seconds * 1000.0 / stats->decisions, stats->maxms);
+}
+
+// The start screen changes only with input and the bird animation, game
+// over not at all. Benchmarks, replays and the autopilot keep running at
+// full rate.
+static boolean P_CanIdle(void) {
+    return config.idle && assetsready && config.bench == BENCH_NONE &&
+        config.playfile == NULL && !config.autopilot && !showprofile &&
+        !rewinding &&
+        sim.state != STATE_PLAY && view.state == sim.state;
+}
+
+// ms until the screen could look different without input.
+static int P_IdleTimeout(void) {
+    if (view.state != STATE_START)
+        return IDLE_TIMEOUT_MS;
+    return speed - (int)(SDL_GetTicks() % (Uint32)speed);
+}
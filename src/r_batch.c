@@ -0,0 +1,168 @@
+/* =============================================================================
+** FlappyBirby, file: r_batch.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "r_batch.h"
+
+static SDL_Renderer *batchrenderer = NULL;
+static SDL_Texture *batchtexture = NULL;
+static float texwidth = 1.0f;
+static float texheight = 1.0f;
+static int vieww = 0;
+static int viewh = 0;
+static uint numquads = 0;
+static RenderStats framestats;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+static SDL_Vertex vertices[R_BATCH_MAX_QUADS * 4];
+static int indices[R_BATCH_MAX_QUADS * 6];
+#else
+// No SDL_RenderGeometry(), fall back to one copy per quad
+static struct {
+    SDL_Rect src;
+    SDL_Rect dst;
+    SDL_RendererFlip flip;
+    SDL_Color color;
+} quads[R_BATCH_MAX_QUADS];
+#endif
+
+void R_BatchBegin(SDL_Renderer *renderer, int viewwidth, int viewheight) {
+    batchrenderer = renderer;
+    batchtexture = NULL;
+    vieww = viewwidth;
+    viewh = viewheight;
+    numquads = 0;
+    framestats.drawcalls = 0;
+    framestats.quads = 0;
+    framestats.culled = 0;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // The index pattern never changes, fill it once
+    if (indices[5] == 0) {
+        for (int i = 0; i < R_BATCH_MAX_QUADS; i++) {
+            indices[i * 6 + 0] = i * 4 + 0;
+            indices[i * 6 + 1] = i * 4 + 1;
+            indices[i * 6 + 2] = i * 4 + 2;
+            indices[i * 6 + 3] = i * 4 + 2;
+            indices[i * 6 + 4] = i * 4 + 3;
+            indices[i * 6 + 5] = i * 4 + 0;
+        }
+    }
+#endif
+}
+
+void R_BatchQuad(SDL_Texture *texture, const SDL_Rect *src,
+                 const SDL_Rect *dst, SDL_RendererFlip flip) {
+    const SDL_Color white = { 255, 255, 255, 255 };
+    R_BatchQuadColor(texture, src, dst, flip, white);
+}
+
+void R_BatchQuadColor(SDL_Texture *texture, const SDL_Rect *src,
+                      const SDL_Rect *dst, SDL_RendererFlip flip,
+                      SDL_Color color) {
+    if (texture == NULL)
+        return; // not loaded yet
+    if (dst->x >= vieww || dst->y >= viewh ||
+        dst->x + dst->w <= 0 || dst->y + dst->h <= 0) {
+        framestats.culled++;
+        return;
+    }
+    if (texture != batchtexture || numquads == R_BATCH_MAX_QUADS) {
+        R_BatchFlush();
+        if (texture != batchtexture) {
+            int w, h;
+            SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+            batchtexture = texture;
+            texwidth = (float)w;
+            texheight = (float)h;
+        }
+    }
+    framestats.quads++;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src != NULL) {
+        u0 = src->x / texwidth;
+        v0 = src->y / texheight;
+        u1 = (src->x + src->w) / texwidth;
+        v1 = (src->y + src->h) / texheight;
+    }
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        const float tmp = u0; u0 = u1; u1 = tmp;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        const float tmp = v0; v0 = v1; v1 = tmp;
+    }
+    const float x0 = (float)dst->x, y0 = (float)dst->y;
+    const float x1 = (float)(dst->x + dst->w), y1 = (float)(dst->y + dst->h);
+    SDL_Vertex *v = &vertices[numquads * 4];
+    v[0].position.x = x0; v[0].position.y = y0;
+    v[0].tex_coord.x = u0; v[0].tex_coord.y = v0;
+    v[1].position.x = x1; v[1].position.y = y0;
+    v[1].tex_coord.x = u1; v[1].tex_coord.y = v0;
+    v[2].position.x = x1; v[2].position.y = y1;
+    v[2].tex_coord.x = u1; v[2].tex_coord.y = v1;
+    v[3].position.x = x0; v[3].position.y = y1;
+    v[3].tex_coord.x = u0; v[3].tex_coord.y = v1;
+    v[0].color = v[1].color = v[2].color = v[3].color = color;
+#else
+    if (src != NULL) {
+        quads[numquads].src = *src;
+    } else {
+        quads[numquads].src.x = quads[numquads].src.y = 0;
+        quads[numquads].src.w = (int)texwidth;
+        quads[numquads].src.h = (int)texheight;
+    }
+    quads[numquads].dst = *dst;
+    quads[numquads].flip = flip;
+    quads[numquads].color = color;
+#endif
+    numquads++;
+}
+
+void R_BatchFlush(void) {
+    if (numquads == 0 || batchtexture == NULL)
+        return;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_RenderGeometry(batchrenderer, batchtexture, vertices, numquads * 4,
+                       indices, numquads * 6);
+    framestats.drawcalls++;
+#else
+    for (uint i = 0; i < numquads; i++) {
+        SDL_SetTextureColorMod(batchtexture, quads[i].color.r,
+                               quads[i].color.g, quads[i].color.b);
+        SDL_SetTextureAlphaMod(batchtexture, quads[i].color.a);
+        SDL_RenderCopyEx(batchrenderer, batchtexture, &quads[i].src,
+                         &quads[i].dst, 0, NULL, quads[i].flip);
+        framestats.drawcalls++;
+    }
+    SDL_SetTextureColorMod(batchtexture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(batchtexture, 255);
+#endif
+    numquads = 0;
+}
+
+void R_BatchEnd(RenderStats *stats) {
+    R_BatchFlush();
+    batchtexture = NULL;
+    if (stats != NULL) {
+        *stats = framestats;
+    }
+}
@@ -0,0 +1,50 @@
+/* =============================================================================
+** FlappyBirby, file: r_batch.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __R_BATCH_H__
+#define __R_BATCH_H__
+
+#include "u_utility.h"
+
+// Sprite batch: quads are queued and consecutive quads sharing a texture go
+// out as one SDL_RenderGeometry() call. Quads fully outside the viewport are
+// dropped before they are queued, as are quads without a texture.
+#define R_BATCH_MAX_QUADS 512
+
+typedef struct {
+    uint drawcalls;
+    uint quads;
+    uint culled;
+} RenderStats;
+
+void R_BatchBegin(SDL_Renderer *renderer, int viewwidth, int viewheight);
+void R_BatchQuad(SDL_Texture *texture, const SDL_Rect *src,
+                 const SDL_Rect *dst, SDL_RendererFlip flip);
+void R_BatchQuadColor(SDL_Texture *texture, const SDL_Rect *src,
+                      const SDL_Rect *dst, SDL_RendererFlip flip,
+                      SDL_Color color);
+void R_BatchFlush(void);
+void R_BatchEnd(RenderStats *stats);
+
+#endif
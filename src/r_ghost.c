@@ -0,0 +1,130 @@
+/* =============================================================================
+** FlappyBirby, file: r_ghost.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "r_ghost.h"
+#include "r_batch.h"
+
+#include <stdlib.h>
+
+#define R_GHOST_MAX_FRAMES 8
+
+static uint ghostcapacity = 0;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+static SDL_Vertex *vertices = NULL;
+static int *indices = NULL;
+#endif
+
+boolean R_GhostInit(uint capacity) {
+    ghostcapacity = capacity;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    vertices = malloc(capacity * 4 * sizeof(SDL_Vertex));
+    indices = malloc(capacity * 6 * sizeof(int));
+    if (vertices == NULL || indices == NULL) {
+        R_GhostFree();
+        return false;
+    }
+    const SDL_Color color = { 255, 255, 255, R_GHOST_ALPHA };
+    for (uint i = 0; i < capacity; i++) {
+        indices[i * 6 + 0] = i * 4 + 0;
+        indices[i * 6 + 1] = i * 4 + 1;
+        indices[i * 6 + 2] = i * 4 + 2;
+        indices[i * 6 + 3] = i * 4 + 2;
+        indices[i * 6 + 4] = i * 4 + 3;
+        indices[i * 6 + 5] = i * 4 + 0;
+        for (uint k = 0; k < 4; k++) {
+            vertices[i * 4 + k].color = color;
+        }
+    }
+#endif
+    return true;
+}
+
+void R_GhostFree(void) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    free(vertices);
+    free(indices);
+    vertices = NULL;
+    indices = NULL;
+#endif
+    ghostcapacity = 0;
+}
+
+// Ghost i shows frames[(anim + phase) % numframes], those of the current tick
+// that are still alive and on screen. Whatever the sprite batch has queued
+// is flushed first so the ghosts keep their place in the draw order.
+void R_GhostDraw(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Rect *frames, uint numframes, uint anim,
+                 const GhostSet *ghosts, int x, int size) {
+    if (texture == NULL || numframes == 0 || numframes > R_GHOST_MAX_FRAMES)
+        return;
+    uint count = ghosts->count;
+    if (count > ghostcapacity) {
+        count = ghostcapacity;
+    }
+    R_BatchFlush();
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    int texw, texh;
+    SDL_QueryTexture(texture, NULL, NULL, &texw, &texh);
+    float uv[R_GHOST_MAX_FRAMES][4];
+    for (uint f = 0; f < numframes; f++) {
+        uv[f][0] = frames[f].x / (float)texw;
+        uv[f][1] = frames[f].y / (float)texh;
+        uv[f][2] = (frames[f].x + frames[f].w) / (float)texw;
+        uv[f][3] = (frames[f].y + frames[f].h) / (float)texh;
+    }
+    const float x0 = (float)x, x1 = (float)(x + size);
+    uint numquads = 0;
+    for (uint i = 0; i < count; i++) {
+        const int y = ghosts->birdy[i];
+        if (ghosts->tick > ghosts->deathtick[i] || y + size <= 0)
+            continue;
+        const float *t = uv[(anim + ghosts->phase[i]) % numframes];
+        const float y0 = (float)y, y1 = (float)(y + size);
+        SDL_Vertex *v = &vertices[numquads * 4];
+        v[0].position.x = x0; v[0].position.y = y0;
+        v[0].tex_coord.x = t[0]; v[0].tex_coord.y = t[1];
+        v[1].position.x = x1; v[1].position.y = y0;
+        v[1].tex_coord.x = t[2]; v[1].tex_coord.y = t[1];
+        v[2].position.x = x1; v[2].position.y = y1;
+        v[2].tex_coord.x = t[2]; v[2].tex_coord.y = t[3];
+        v[3].position.x = x0; v[3].position.y = y1;
+        v[3].tex_coord.x = t[0]; v[3].tex_coord.y = t[3];
+        numquads++;
+    }
+    if (numquads > 0) {
+        SDL_RenderGeometry(renderer, texture, vertices, numquads * 4, indices,
+                           numquads * 6);
+    }
+#else
+    SDL_SetTextureAlphaMod(texture, R_GHOST_ALPHA);
+    for (uint i = 0; i < count; i++) {
+        const SDL_Rect dst = { x, ghosts->birdy[i], size, size };
+        if (ghosts->tick > ghosts->deathtick[i] || dst.y + size <= 0)
+            continue;
+        SDL_RenderCopy(renderer, texture,
+                       &frames[(anim + ghosts->phase[i]) % numframes], &dst);
+    }
+    SDL_SetTextureAlphaMod(texture, 255);
+#endif
+}
@@ -0,0 +1,41 @@
+/* =============================================================================
+** FlappyBirby, file: r_ghost.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __R_GHOST_H__
+#define __R_GHOST_H__
+
+#include "s_ghost.h"
+
+// Every ghost of a GhostSet goes out in one SDL_RenderGeometry() call. The
+// vertex arrays are sized for the whole set up front and the animation
+// frame of each ghost is looked up in a table of texture coordinates.
+#define R_GHOST_ALPHA 96
+
+boolean R_GhostInit(uint capacity);
+void R_GhostFree(void);
+void R_GhostDraw(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Rect *frames, uint numframes, uint anim,
+                 const GhostSet *ghosts, int x, int size);
+
+#endif
@@ -0,0 +1,148 @@
+/* =============================================================================
+** FlappyBirby, file: r_hud.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "r_hud.h"
+#include "r_batch.h"
+
+#include <stdio.h>
+
+#define HUD_NUM_GLYPHS 10
+#define HUD_MAX_DIGITS 12
+
+static SDL_Surface *glyphsurface = NULL;
+static SDL_Texture *glyphtexture = NULL;
+static SDL_Rect glyphs[HUD_NUM_GLYPHS];
+// Quads of the last drawn score, only rebuilt when the score changes
+static SDL_Rect digitsrc[HUD_MAX_DIGITS];
+static SDL_Rect digitdst[HUD_MAX_DIGITS];
+static uint numdigits = 0;
+static int cachedscore = -1;
+static int cachedx = 0;
+static int cachedy = 0;
+
+boolean R_HudBuild(TTF_Font *font, SDL_Color color) {
+    SDL_Surface *rendered[HUD_NUM_GLYPHS];
+    int atlasw = 0, atlash = 0;
+
+    for (uint i = 0; i < HUD_NUM_GLYPHS; i++) {
+        rendered[i] = TTF_RenderGlyph_Blended(font, (Uint16)('0' + i), color);
+        if (rendered[i] == NULL) {
+            while (i > 0)
+                SDL_FreeSurface(rendered[--i]);
+            return false;
+        }
+        glyphs[i].x = atlasw;
+        glyphs[i].y = 0;
+        glyphs[i].w = rendered[i]->w;
+        glyphs[i].h = rendered[i]->h;
+        atlasw += rendered[i]->w + 1;
+        if (rendered[i]->h > atlash)
+            atlash = rendered[i]->h;
+    }
+    glyphsurface = SDL_CreateRGBSurfaceWithFormat(0, atlasw, atlash, 32,
+                                                  SDL_PIXELFORMAT_RGBA32);
+    for (uint i = 0; i < HUD_NUM_GLYPHS; i++) {
+        if (glyphsurface != NULL) {
+            SDL_SetSurfaceBlendMode(rendered[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(rendered[i], NULL, glyphsurface, &glyphs[i]);
+        }
+        SDL_FreeSurface(rendered[i]);
+    }
+    return glyphsurface != NULL;
+}
+
+boolean R_HudUpload(SDL_Renderer *renderer) {
+    glyphtexture = SDL_CreateTextureFromSurface(renderer, glyphsurface);
+    SDL_FreeSurface(glyphsurface);
+    glyphsurface = NULL;
+    cachedscore = -1;
+    return glyphtexture != NULL;
+}
+
+void R_HudDraw(int score, int centerx, int y) {
+    if (glyphtexture == NULL)
+        return;
+    if (score != cachedscore || centerx != cachedx || y != cachedy) {
+        char digits[HUD_MAX_DIGITS + 1];
+        const int len = snprintf(digits, sizeof(digits), "%d", score);
+        int x = 0;
+        numdigits = 0;
+        for (int i = 0; i < len && numdigits < HUD_MAX_DIGITS; i++) {
+            if (digits[i] < '0' || digits[i] > '9')
+                continue;
+            const SDL_Rect *glyph = &glyphs[digits[i] - '0'];
+            digitsrc[numdigits] = *glyph;
+            digitdst[numdigits].x = x;
+            digitdst[numdigits].y = y;
+            digitdst[numdigits].w = glyph->w;
+            digitdst[numdigits].h = glyph->h;
+            x += glyph->w;
+            numdigits++;
+        }
+        for (uint i = 0; i < numdigits; i++) {
+            digitdst[i].x += centerx - x / 2;
+        }
+        cachedscore = score;
+        cachedx = centerx;
+        cachedy = y;
+    }
+    for (uint i = 0; i < numdigits; i++) {
+        R_BatchQuad(glyphtexture, &digitsrc[i], &digitdst[i], SDL_FLIP_NONE);
+    }
+}
+
+// Scaled to height and not cached, for the few numbers of a screen that
+// doesn't change.
+void R_HudDrawSized(int score, int centerx, int y, int height) {
+    if (glyphtexture == NULL)
+        return;
+    char digits[HUD_MAX_DIGITS + 1];
+    const int len = snprintf(digits, sizeof(digits), "%d", score);
+    SDL_Rect dst[HUD_MAX_DIGITS];
+    const SDL_Rect *src[HUD_MAX_DIGITS];
+    uint count = 0;
+    int x = 0;
+    for (int i = 0; i < len && count < HUD_MAX_DIGITS; i++) {
+        if (digits[i] < '0' || digits[i] > '9')
+            continue;
+        src[count] = &glyphs[digits[i] - '0'];
+        dst[count].x = x;
+        dst[count].y = y;
+        dst[count].w = src[count]->w * height / src[count]->h;
+        dst[count].h = height;
+        x += dst[count].w;
+        count++;
+    }
+    for (uint i = 0; i < count; i++) {
+        dst[i].x += centerx - x / 2;
+        R_BatchQuad(glyphtexture, src[i], &dst[i], SDL_FLIP_NONE);
+    }
+}
+
+void R_HudFree(void) {
+    SDL_FreeSurface(glyphsurface);
+    SDL_DestroyTexture(glyphtexture);
+    glyphsurface = NULL;
+    glyphtexture = NULL;
+}
@@ -0,0 +1,41 @@
+/* =============================================================================
+** FlappyBirby, file: r_hud.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __R_HUD_H__
+#define __R_HUD_H__
+
+#include <SDL2/SDL_ttf.h>
+
+#include "u_utility.h"
+
+// Score display drawn from a glyph atlas of the digits. R_HudBuild() only
+// touches the font and surfaces so it can run on the loader thread, the
+// texture is created later by R_HudUpload() on the render thread.
+boolean R_HudBuild(TTF_Font *font, SDL_Color color);
+boolean R_HudUpload(SDL_Renderer *renderer);
+void R_HudDraw(int score, int centerx, int y);
+void R_HudDrawSized(int score, int centerx, int y, int height);
+void R_HudFree(void);
+
+#endif
@@ -0,0 +1,97 @@
+/* =============================================================================
+** FlappyBirby, file: r_prof.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "r_prof.h"
+#include "r_batch.h"
+#include "u_prof.h"
+
+#include <stdio.h>
+
+#define PROF_TEXT_SCALE 4 // the game font is huge, draw it a quarter size
+#define PROF_TEXT_WRAP 2400
+#define PROF_MARGIN 8
+
+static SDL_Texture *texttexture = NULL;
+static SDL_Rect textrect;
+static Uint32 lastrefresh = 0;
+
+static void R_ProfRefresh(SDL_Renderer *renderer, TTF_Font *font);
+
+// Call between R_BatchBegin() and R_BatchEnd(), after the game is drawn.
+void R_ProfDraw(SDL_Renderer *renderer, TTF_Font *font) {
+    if (font == NULL)
+        return;
+    const Uint32 now = SDL_GetTicks();
+    if (texttexture == NULL || now - lastrefresh >= R_PROF_REFRESH_MS) {
+        R_ProfRefresh(renderer, font);
+        lastrefresh = now;
+    }
+    if (texttexture == NULL)
+        return;
+    // Darken what is behind the text, this bypasses the batch so flush first
+    SDL_Rect backrect = textrect;
+    backrect.x -= PROF_MARGIN / 2;
+    backrect.y -= PROF_MARGIN / 2;
+    backrect.w += PROF_MARGIN;
+    backrect.h += PROF_MARGIN;
+    R_BatchFlush();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &backrect);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    R_BatchQuad(texttexture, NULL, &textrect, SDL_FLIP_NONE);
+}
+
+void R_ProfFree(void) {
+    SDL_DestroyTexture(texttexture);
+    texttexture = NULL;
+}
+
+static void R_ProfRefresh(SDL_Renderer *renderer, TTF_Font *font) {
+    ProfStats stats[PROF_MAX_PHASES + 1];
+    char text[PROF_MAX_PHASES * 64 + 128];
+    const uint numphases = U_ProfNumPhases();
+    const uint frames = U_ProfStats(stats, R_PROF_FRAMES);
+    int len = snprintf(text, sizeof(text), "%u frames   min  avg  p99 ms\n",
+                       frames);
+    for (uint p = 0; p <= numphases && len < (int)sizeof(text); p++) {
+        len += snprintf(text + len, sizeof(text) - len,
+                        "%-10s %5.2f %5.2f %5.2f\n",
+                        p < numphases ? U_ProfName(p) : "frame",
+                        stats[p].min, stats[p].avg, stats[p].p99);
+    }
+
+    SDL_Color color = { 255, 255, 255, 255 };
+    SDL_Surface *surface = TTF_RenderText_Blended_Wrapped(font, text, color,
+                                                          PROF_TEXT_WRAP);
+    if (surface == NULL)
+        return;
+    SDL_DestroyTexture(texttexture);
+    texttexture = SDL_CreateTextureFromSurface(renderer, surface);
+    textrect.x = PROF_MARGIN;
+    textrect.y = PROF_MARGIN;
+    textrect.w = surface->w / PROF_TEXT_SCALE;
+    textrect.h = surface->h / PROF_TEXT_SCALE;
+    SDL_FreeSurface(surface);
+}
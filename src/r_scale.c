@@ -0,0 +1,126 @@
+/* =============================================================================
+** FlappyBirby, file: r_scale.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "r_scale.h"
+
+static SDL_Renderer *scalerenderer = NULL;
+static SDL_Texture *target = NULL;
+static int viewwidth = 0;
+static int viewheight = 0;
+static int targetwidth = 0;
+static int targetheight = 0;
+static float scale = 1.0f;
+static double budget = 0.0; // ms, 0 keeps the scale fixed
+static double drawms = 0.0; // smoothed, 0 until the first frame at a scale
+static uint hold = 0; // frames until the scale may change again
+static Uint64 beginstamp = 0;
+
+static boolean R_ScaleCreate(float newscale);
+
+// startscale is kept as is without a budget, with one it is where it starts.
+// Fails if the renderer can't draw to textures.
+boolean R_ScaleInit(SDL_Renderer *renderer, int width, int height,
+                    float startscale, double budgetms) {
+    scalerenderer = renderer;
+    viewwidth = width;
+    viewheight = height;
+    budget = budgetms;
+    drawms = 0.0;
+    hold = R_SCALE_HOLD;
+    if (!SDL_RenderTargetSupported(renderer))
+        return false;
+    if (startscale < R_SCALE_MIN)
+        startscale = R_SCALE_MIN;
+    if (startscale > 1.0f)
+        startscale = 1.0f;
+    return R_ScaleCreate(startscale);
+}
+
+// Call before anything of the frame is drawn, coordinates stay in the
+// view's size.
+void R_ScaleBegin(void) {
+    beginstamp = SDL_GetPerformanceCounter();
+    SDL_SetRenderTarget(scalerenderer, target);
+    SDL_RenderSetScale(scalerenderer, (float)targetwidth / viewwidth,
+                       (float)targetheight / viewheight);
+}
+
+// Call after R_BatchEnd(), before presenting.
+void R_ScaleEnd(void) {
+    // Switching back to the window runs everything queued for the texture
+    SDL_SetRenderTarget(scalerenderer, NULL);
+    const double ms = (SDL_GetPerformanceCounter() - beginstamp) * 1000.0 /
+        SDL_GetPerformanceFrequency();
+    SDL_RenderCopy(scalerenderer, target, NULL, NULL);
+    if (budget <= 0.0)
+        return;
+
+    drawms = drawms == 0.0 ? ms : drawms + (ms - drawms) * R_SCALE_SMOOTH;
+    if (hold > 0) {
+        hold--;
+        return;
+    }
+    float next = scale;
+    if (drawms > budget * R_SCALE_HIGH && scale > R_SCALE_MIN) {
+        next = scale - R_SCALE_STEP;
+    } else if (drawms < budget * R_SCALE_LOW && scale < 1.0f) {
+        next = scale + R_SCALE_STEP;
+    }
+    if (next < R_SCALE_MIN)
+        next = R_SCALE_MIN;
+    if (next > 1.0f)
+        next = 1.0f;
+    // Keep the old texture if a new one can't be had
+    if (next != scale && R_ScaleCreate(next)) {
+        hold = R_SCALE_HOLD;
+        drawms = 0.0;
+    }
+}
+
+float R_ScaleGet(void) {
+    return scale;
+}
+
+void R_ScaleFree(void) {
+    SDL_DestroyTexture(target);
+    target = NULL;
+}
+
+static boolean R_ScaleCreate(float newscale) {
+    const int width = (int)(viewwidth * newscale + 0.5f);
+    const int height = (int)(viewheight * newscale + 0.5f);
+    SDL_Texture *texture = SDL_CreateTexture(scalerenderer,
+                                             SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_TARGET,
+                                             width, height);
+    if (texture == NULL)
+        return false;
+    SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+    SDL_DestroyTexture(target);
+    target = texture;
+    targetwidth = width;
+    targetheight = height;
+    scale = newscale;
+    return true;
+}
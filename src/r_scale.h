@@ -0,0 +1,49 @@
+/* =============================================================================
+** FlappyBirby, file: r_scale.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __R_SCALE_H__
+#define __R_SCALE_H__
+
+#include "u_utility.h"
+
+// Draws the game into an offscreen texture, possibly smaller than the
+// window, and stretches it over the window at the end of the frame. With a
+// budget the resolution follows the time drawing takes: lowered when a
+// frame uses most of the budget, raised again once there is room. Only CPU
+// time is seen, which is what counts on the software renderer.
+#define R_SCALE_MIN 0.25f
+#define R_SCALE_STEP 0.125f
+#define R_SCALE_HOLD 30 // frames between two changes
+#define R_SCALE_HIGH 0.85 // of the budget, lower the resolution above
+#define R_SCALE_LOW 0.5 // and raise it below
+#define R_SCALE_SMOOTH 0.1 // weight of the newest frame in the average
+
+boolean R_ScaleInit(SDL_Renderer *renderer, int width, int height,
+                    float startscale, double budgetms);
+void R_ScaleBegin(void);
+void R_ScaleEnd(void);
+float R_ScaleGet(void);
+void R_ScaleFree(void);
+
+#endif
@@ -0,0 +1,161 @@
+/* =============================================================================
+** FlappyBirby, file: r_soft.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "r_soft.h"
+#include "s_sim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SOFT_ALPHA 128 // atlas alpha from which a pixel counts as opaque
+
+// Shades used when there is no bundle to take the sprites from
+static const Uint8 flatshades[SOFT_NUM_SPRITES] = { 160, 255, 0, 60 };
+// Same names as spritefiles in main.c, the bird is the first frame of its
+// strip
+static const char *spritenames[SOFT_NUM_SPRITES] = {
+    "bgTex.webp", "birbTile.webp", "ground.webp", "pipe.webp",
+};
+static const int birdframe[2] = { 65, 68 };
+
+static boolean R_SoftConvert(SoftSprite *sprite, const Pak *pak,
+                             const PakEntry *entry, int w, int h);
+static int R_SoftFirst(int from, int factor);
+
+// Sprites come from the bundle when pak is not NULL, otherwise everything
+// is a flat shade and the ground is left out.
+boolean R_SoftInit(SoftRaster *raster, const Pak *pak, int factor) {
+    memset(raster, 0, sizeof(*raster));
+    raster->factor = factor > 0 ? factor : 1;
+    raster->width = SIM_WIDTH / raster->factor;
+    raster->height = SIM_HEIGHT / raster->factor;
+    for (uint i = 0; i < SOFT_NUM_SPRITES; i++) {
+        SoftSprite *sprite = &raster->sprites[i];
+        const PakEntry *entry = pak != NULL ?
+            A_PakFind(pak, spritenames[i], PAK_SPRITE) : NULL;
+        if (entry != NULL) {
+            const int w = i == SOFT_BIRD ? birdframe[0] : (int)entry->w;
+            const int h = i == SOFT_BIRD ? birdframe[1] : (int)entry->h;
+            if (!R_SoftConvert(sprite, pak, entry, w, h)) {
+                R_SoftFree(raster);
+                return false;
+            }
+        } else if (flatshades[i] != 0) {
+            sprite->pixels = malloc(1);
+            if (sprite->pixels == NULL) {
+                R_SoftFree(raster);
+                return false;
+            }
+            sprite->pixels[0] = flatshades[i];
+            sprite->w = sprite->h = 1;
+        }
+    }
+    raster->background = malloc((size_t)raster->width * raster->height);
+    if (raster->background == NULL) {
+        R_SoftFree(raster);
+        return false;
+    }
+    const SDL_Rect screen = { 0, 0, SIM_WIDTH, SIM_HEIGHT };
+    memset(raster->background, 0, (size_t)raster->width * raster->height);
+    R_SoftSprite(raster, raster->background, SOFT_BACKGROUND, &screen, false);
+    return true;
+}
+
+void R_SoftFree(SoftRaster *raster) {
+    for (uint i = 0; i < SOFT_NUM_SPRITES; i++) {
+        free(raster->sprites[i].pixels);
+        raster->sprites[i].pixels = NULL;
+    }
+    free(raster->background);
+    raster->background = NULL;
+}
+
+void R_SoftClear(const SoftRaster *raster, Uint8 *frame) {
+    memcpy(frame, raster->background,
+           (size_t)raster->width * raster->height);
+}
+
+// dst is in world pixels like the rects R_BatchQuad() gets, flip mirrors
+// the sprite vertically like SDL_FLIP_VERTICAL.
+void R_SoftSprite(const SoftRaster *raster, Uint8 *frame, uint sprite,
+                  const SDL_Rect *dst, boolean flip) {
+    const SoftSprite *src = &raster->sprites[sprite];
+    const int f = raster->factor;
+    int columns[SIM_WIDTH];
+    if (src->pixels == NULL || dst->w <= 0 || dst->h <= 0)
+        return;
+
+    int x0 = R_SoftFirst(dst->x, f);
+    int x1 = R_SoftFirst(dst->x + dst->w, f);
+    int y0 = R_SoftFirst(dst->y, f);
+    int y1 = R_SoftFirst(dst->y + dst->h, f);
+    x0 = x0 > 0 ? x0 : 0;
+    y0 = y0 > 0 ? y0 : 0;
+    x1 = x1 < raster->width ? x1 : raster->width;
+    y1 = y1 < raster->height ? y1 : raster->height;
+    for (int x = x0; x < x1; x++) {
+        const int wx = x * f + f / 2 - dst->x;
+        columns[x] = (int)((Sint64)wx * src->w / dst->w);
+    }
+    for (int y = y0; y < y1; y++) {
+        const int wy = y * f + f / 2 - dst->y;
+        int v = (int)((Sint64)wy * src->h / dst->h);
+        if (flip) {
+            v = src->h - 1 - v;
+        }
+        const Uint8 *row = src->pixels + (size_t)v * src->w;
+        Uint8 *out = frame + (size_t)y * raster->width;
+        for (int x = x0; x < x1; x++) {
+            const Uint8 gray = row[columns[x]];
+            out[x] = gray != 0 ? gray : out[x];
+        }
+    }
+}
+
+static boolean R_SoftConvert(SoftSprite *sprite, const Pak *pak,
+                             const PakEntry *entry, int w, int h) {
+    const PakHeader *header = pak->header;
+    const Uint8 *atlas = A_PakAtlas(pak);
+    sprite->pixels = malloc((size_t)w * h);
+    if (sprite->pixels == NULL)
+        return false;
+    sprite->w = w;
+    sprite->h = h;
+    for (int y = 0; y < h; y++) {
+        const Uint8 *in = atlas +
+            ((size_t)(entry->y + y) * header->atlaswidth + entry->x) * 4;
+        for (int x = 0; x < w; x++, in += 4) {
+            const int gray = (77 * in[0] + 150 * in[1] + 29 * in[2] + 128) >> 8;
+            sprite->pixels[(size_t)y * w + x] = in[3] < SOFT_ALPHA ? 0 :
+                (Uint8)(gray > 0 ? gray : 1);
+        }
+    }
+    return true;
+}
+
+// First frame pixel whose center is at or right of world coordinate from.
+static int R_SoftFirst(int from, int factor) {
+    const int n = from - factor / 2 + factor - 1;
+    return n >= 0 ? n / factor : -((-n + factor - 1) / factor);
+}
@@ -0,0 +1,63 @@
+/* =============================================================================
+** FlappyBirby, file: r_soft.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __R_SOFT_H__
+#define __R_SOFT_H__
+
+#include "u_utility.h"
+#include "a_pak.h"
+
+// Software rasterizer for small grayscale frames of the game, no renderer
+// or window needed. Every frame pixel samples the world pixel at its center
+// (nearest, factor world pixels apart), sprites are converted to gray with
+// a 1-bit alpha once: 0 is transparent, opaque gray is 1 to 255.
+enum softsprite_t {
+    SOFT_BACKGROUND = 0,
+    SOFT_BIRD,
+    SOFT_GROUND,
+    SOFT_PIPE,
+    SOFT_NUM_SPRITES,
+};
+
+typedef struct {
+    Uint8 *pixels;
+    int w;
+    int h;
+} SoftSprite;
+
+typedef struct {
+    int width; // of a frame
+    int height;
+    int factor; // world pixels per frame pixel
+    SoftSprite sprites[SOFT_NUM_SPRITES];
+    Uint8 *background; // a frame with just the background
+} SoftRaster;
+
+boolean R_SoftInit(SoftRaster *raster, const Pak *pak, int factor);
+void R_SoftFree(SoftRaster *raster);
+void R_SoftClear(const SoftRaster *raster, Uint8 *frame);
+void R_SoftSprite(const SoftRaster *raster, Uint8 *frame, uint sprite,
+                  const SDL_Rect *dst, boolean flip);
+
+#endif
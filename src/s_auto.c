@@ -0,0 +1,183 @@
+/* =============================================================================
+** FlappyBirby, file: s_auto.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_auto.h"
+
+#define AUTO_NUM_TASKS (1u << AUTO_SPLIT_DEPTH)
+
+typedef struct {
+    const AutoPilot *pilot;
+    const SimState *root;
+    Uint64 deadline;
+    SDL_atomic_t timedout;
+    uint values[AUTO_NUM_TASKS]; // ticks survived by the best line found
+    Uint64 nodes[AUTO_NUM_TASKS];
+} AutoJob;
+
+// Kept on the stack of the task, the counters are bumped every node
+typedef struct {
+    AutoJob *job;
+    Uint64 nodes;
+    Uint64 nextcheck;
+    boolean stopped;
+} AutoTask;
+
+static void S_AutoTask(void *data, uint index);
+static uint S_AutoSearch(AutoTask *task, const SimState *sim, uint ticks);
+static boolean S_AutoPlay(AutoTask *task, SimState *sim, boolean flap,
+                          uint *ticks);
+
+// numthreads 0 searches on every CPU.
+boolean S_AutoCreate(AutoPilot *pilot, uint numthreads, uint tickrate,
+                     double budgetms) {
+    pilot->horizon = tickrate * AUTO_HORIZON_MS / 1000;
+    pilot->step = tickrate * AUTO_STEP_MS / 1000;
+    if (pilot->step == 0) {
+        pilot->step = 1;
+    }
+    if (pilot->horizon < pilot->step) {
+        pilot->horizon = pilot->step;
+    }
+    pilot->split = pilot->horizon / pilot->step;
+    if (pilot->split > AUTO_SPLIT_DEPTH) {
+        pilot->split = AUTO_SPLIT_DEPTH;
+    }
+    pilot->budget = (Uint64)(budgetms * SDL_GetPerformanceFrequency() / 1000.0);
+    SDL_zero(pilot->stats);
+    return U_PoolCreate(&pilot->pool, numthreads);
+}
+
+void S_AutoDestroy(AutoPilot *pilot) {
+    U_PoolDestroy(&pilot->pool);
+}
+
+// Starts a run from the start screen, otherwise flaps when that lets the
+// bird live longer than not flapping, within the horizon.
+boolean S_AutoFlap(AutoPilot *pilot, const SimState *sim) {
+    if (sim->state != STATE_PLAY)
+        return sim->state == STATE_START;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    AutoJob job;
+    job.pilot = pilot;
+    job.root = sim;
+    job.deadline = start + pilot->budget;
+    SDL_AtomicSet(&job.timedout, 0);
+    const uint numtasks = 1u << pilot->split;
+    U_PoolRun(&pilot->pool, S_AutoTask, &job, numtasks);
+
+    // The first choice is the top bit of the task index
+    uint best[2] = { 0, 0 };
+    for (uint i = 0; i < numtasks; i++) {
+        const uint flap = i >> (pilot->split - 1);
+        if (job.values[i] > best[flap]) {
+            best[flap] = job.values[i];
+        }
+        pilot->stats.nodes += job.nodes[i];
+    }
+
+    const double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 /
+        SDL_GetPerformanceFrequency();
+    AutoStats *stats = &pilot->stats;
+    if (stats->decisions == 0 || ms < stats->minms) {
+        stats->minms = ms;
+    }
+    if (ms > stats->maxms) {
+        stats->maxms = ms;
+    }
+    stats->seconds += ms / 1000.0;
+    stats->decisions++;
+    if (SDL_AtomicGet(&job.timedout)) {
+        stats->timeouts++;
+    }
+    return best[1] > best[0]; // a tie keeps the bird from climbing
+}
+
+// Plays the choices in the bits of index, then searches on from there.
+static void S_AutoTask(void *data, uint index) {
+    AutoJob *job = data;
+    const AutoPilot *pilot = job->pilot;
+    AutoTask task;
+    task.job = job;
+    task.nodes = 0;
+    task.nextcheck = AUTO_CHECK_NODES;
+    task.stopped = false;
+
+    SimState sim = *job->root;
+    uint ticks = 0;
+    boolean alive = true;
+    for (uint level = 0; level < pilot->split && alive; level++) {
+        const boolean flap = (index >> (pilot->split - 1 - level)) & 1;
+        alive = S_AutoPlay(&task, &sim, flap, &ticks);
+    }
+    job->values[index] = alive ? S_AutoSearch(&task, &sim, ticks) : ticks;
+    job->nodes[index] = task.nodes;
+}
+
+// Depth first, falling tried before flapping. Returns the most ticks any
+// line from sim survives, counted from the root.
+static uint S_AutoSearch(AutoTask *task, const SimState *sim, uint ticks) {
+    const AutoJob *job = task->job;
+    if (ticks >= job->pilot->horizon)
+        return ticks;
+    if (task->nodes >= task->nextcheck) {
+        task->nextcheck = task->nodes + AUTO_CHECK_NODES;
+        if (SDL_GetPerformanceCounter() > job->deadline) {
+            SDL_AtomicSet(&task->job->timedout, 1);
+        }
+        task->stopped = SDL_AtomicGet(&task->job->timedout) != 0;
+    }
+    if (task->stopped)
+        return ticks; // out of time, count the line as far as it got
+
+    uint best = ticks;
+    for (int flap = 0; flap < 2 && best < job->pilot->horizon; flap++) {
+        SimState next = *sim; // the state is flat, branching is a copy
+        uint survived = ticks;
+        const boolean alive = S_AutoPlay(task, &next, flap, &survived);
+        const uint value = alive ?
+            S_AutoSearch(task, &next, survived) : survived;
+        if (value > best) {
+            best = value;
+        }
+    }
+    return best;
+}
+
+// One choice: flap or not on the first tick, then fall for the rest of the
+// step. False when the bird dies on the way.
+static boolean S_AutoPlay(AutoTask *task, SimState *sim, boolean flap,
+                          uint *ticks) {
+    const AutoPilot *pilot = task->job->pilot;
+    SimInput input;
+    input.flap = flap;
+    for (uint t = 0; t < pilot->step && *ticks < pilot->horizon; t++) {
+        const uint events = S_Step(sim, &input);
+        input.flap = false;
+        task->nodes++;
+        (*ticks)++;
+        if (events & SIM_EVENT_DEATH)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+/* =============================================================================
+** FlappyBirby, file: s_auto.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_AUTO_H__
+#define __S_AUTO_H__
+
+#include "s_sim.h"
+#include "u_pool.h"
+
+// Decides every tick whether to flap by searching the game tree ahead of a
+// copy of the sim. A flap is only tried every AUTO_STEP_MS, and the first
+// AUTO_SPLIT_DEPTH choices are split into subtrees searched on a Pool. A
+// subtree stops as soon as one line of play survives the whole horizon or
+// the time budget of the decision runs out.
+#define AUTO_HORIZON_MS 1000
+#define AUTO_STEP_MS 50
+#define AUTO_SPLIT_DEPTH 5 // 32 subtrees, enough to keep the pool balanced
+#define AUTO_BUDGET_MS 1.0 // per decision, default
+#define AUTO_CHECK_NODES 256 // S_Step() calls between looks at the clock
+
+typedef struct {
+    Uint64 nodes; // S_Step() calls on copies of the sim
+    uint decisions;
+    uint timeouts; // decisions the budget cut short
+    double seconds; // spent deciding
+    double minms;
+    double maxms;
+} AutoStats;
+
+typedef struct {
+    Pool pool;
+    uint horizon; // ticks looked ahead
+    uint step; // ticks between choices
+    uint split; // levels split over the pool, at most AUTO_SPLIT_DEPTH
+    Uint64 budget; // performance counter ticks per decision
+    AutoStats stats;
+} AutoPilot;
+
+boolean S_AutoCreate(AutoPilot *pilot, uint numthreads, uint tickrate,
+                     double budgetms);
+void S_AutoDestroy(AutoPilot *pilot);
+boolean S_AutoFlap(AutoPilot *pilot, const SimState *sim);
+
+#endif
@@ -0,0 +1,243 @@
+/* =============================================================================
+** FlappyBirby, file: s_batch.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_batch.h"
+
+#include <stdlib.h>
+
+// The broad phase tests each lane against one pipe per tick, so no pipe may
+// slide past the bird between two ticks. Even at one tick per second a
+// tick's scroll (see S_Advance()) stays below SIM_MIN_SPACING, the width a
+// pipe and the bird span together, and --ramp never spaces pipes closer.
+SDL_COMPILE_TIME_ASSERT(scroll_below_spacing,
+                        1000 / SIM_SPEED_MS + 1 < SIM_MIN_SPACING);
+
+static void S_BatchScroll(uint n, int scroll, int *restrict pipex,
+                          const Uint8 *restrict alive);
+static void S_BatchCollide(uint n, int scroll, const int *restrict nearx,
+                           const int *restrict neary,
+                           const int *restrict neargap,
+                           const int *restrict birdy, Uint8 *restrict alive,
+                           int *restrict score);
+static void S_BatchGeneratePipes(SimBatch *batch, uint lane);
+static void S_BatchRecyclePipe(SimBatch *batch, uint lane);
+static void S_BatchStartLane(SimBatch *batch, uint lane);
+
+boolean S_BatchCreate(SimBatch *batch, uint count, uint tickrate,
+                      const SimLayout *layout, Uint64 seed) {
+    const size_t n = count;
+    batch->count = count;
+    batch->tickrate = tickrate > 0 ? tickrate : SIM_TICK_RATE;
+    batch->movefrac = 0;
+    if (layout != NULL) {
+        batch->layout = *layout;
+        S_ClampLayout(&batch->layout);
+    } else {
+        S_DefaultLayout(&batch->layout);
+    }
+    batch->seed = seed;
+    batch->run = malloc(n * sizeof(uint));
+    batch->rng = malloc(n * sizeof(RandomState));
+    batch->birdy = malloc(n * sizeof(int));
+    batch->pipex = malloc(n * SIM_NUM_PIPES * sizeof(int));
+    batch->pipey = malloc(n * SIM_NUM_PIPES * sizeof(int));
+    batch->pipegap = malloc(n * SIM_NUM_PIPES * sizeof(int));
+    batch->groundx = malloc(n * sizeof(int));
+    batch->score = malloc(n * sizeof(int));
+    batch->alive = malloc(n);
+    batch->headpipe = malloc(n);
+    batch->nextpipe = malloc(n);
+    batch->nearx = malloc(n * sizeof(int));
+    batch->neary = malloc(n * sizeof(int));
+    batch->neargap = malloc(n * sizeof(int));
+    if (batch->run == NULL || batch->rng == NULL || batch->birdy == NULL ||
+        batch->pipex == NULL || batch->pipey == NULL ||
+        batch->pipegap == NULL || batch->groundx == NULL ||
+        batch->score == NULL || batch->alive == NULL ||
+        batch->headpipe == NULL || batch->nextpipe == NULL ||
+        batch->nearx == NULL || batch->neary == NULL ||
+        batch->neargap == NULL) {
+        S_BatchDestroy(batch);
+        return false;
+    }
+    S_BatchReset(batch);
+    return true;
+}
+
+void S_BatchDestroy(SimBatch *batch) {
+    free(batch->run);
+    free(batch->rng);
+    free(batch->birdy);
+    free(batch->pipex);
+    free(batch->pipey);
+    free(batch->pipegap);
+    free(batch->groundx);
+    free(batch->score);
+    free(batch->alive);
+    free(batch->headpipe);
+    free(batch->nextpipe);
+    free(batch->nearx);
+    free(batch->neary);
+    free(batch->neargap);
+    batch->run = NULL;
+    batch->rng = NULL;
+    batch->birdy = NULL;
+    batch->pipex = batch->pipey = batch->pipegap = NULL;
+    batch->groundx = batch->score = NULL;
+    batch->alive = batch->headpipe = batch->nextpipe = NULL;
+    batch->nearx = batch->neary = batch->neargap = NULL;
+    batch->count = 0;
+}
+
+// Every lane back to its first run of the seed.
+void S_BatchReset(SimBatch *batch) {
+    for (uint i = 0; i < batch->count; i++) {
+        batch->run[i] = i;
+        S_BatchStartLane(batch, i);
+    }
+}
+
+// The lane's next run, like S_Reset() after a game over.
+void S_BatchResetLane(SimBatch *batch, uint lane) {
+    batch->run[lane] += batch->count;
+    S_BatchStartLane(batch, lane);
+}
+
+static void S_BatchStartLane(SimBatch *batch, uint lane) {
+    U_RandomSeed(&batch->rng[lane], batch->seed, batch->run[lane]);
+    batch->birdy[lane] = SIM_BIRD_Y;
+    batch->groundx[lane] = 0;
+    batch->score[lane] = 0;
+    batch->alive[lane] = 1;
+    S_BatchGeneratePipes(batch, lane);
+}
+
+// Same rules as S_Play() in s_sim.c, written without branches in the lane
+// loops. Dead lanes are advanced by zero so they keep their final state.
+uint S_BatchStep(SimBatch *batch, const Uint8 *flaps) {
+    const uint n = batch->count;
+    const int scroll = S_Advance(&batch->movefrac, batch->tickrate);
+    const int bx = SIM_BIRD_X;
+    const int maxy = SIM_HEIGHT - (SIM_BIRD_SIZE / 2);
+    int *restrict birdy = batch->birdy;
+    int *restrict groundx = batch->groundx;
+    Uint8 *restrict alive = batch->alive;
+    uint numalive = 0;
+
+    for (uint i = 0; i < n; i++) {
+        const int live = alive[i];
+        int y = birdy[i] + live * (scroll - (flaps[i] != 0) * SIM_FLAP_HEIGHT);
+        birdy[i] = y < maxy ? y : maxy;
+        const int gx = groundx[i];
+        groundx[i] = gx <= -SIM_WIDTH ? 0 : gx - live * scroll;
+    }
+    for (uint p = 0; p < SIM_NUM_PIPES; p++) {
+        S_BatchScroll(n, scroll, batch->pipex + (size_t)p * n, alive);
+    }
+
+    // Broad phase: recycle pipes that left the screen and gather each lane's
+    // nearest pipe into nearx/neary/neargap. Pipes are at least
+    // SIM_MIN_SPACING apart, so no other pipe can overlap the bird as well.
+    for (uint i = 0; i < n; i++) {
+        while (batch->pipex[batch->headpipe[i] * n + i] + SIM_PIPE_WIDTH < 0) {
+            S_BatchRecyclePipe(batch, i);
+        }
+        uint p = batch->nextpipe[i];
+        while (batch->pipex[p * n + i] + SIM_PIPE_WIDTH <= bx) {
+            p = (p + 1) % SIM_NUM_PIPES;
+        }
+        batch->nextpipe[i] = (Uint8)p;
+        batch->nearx[i] = batch->pipex[p * n + i];
+        batch->neary[i] = batch->pipey[p * n + i];
+        batch->neargap[i] = batch->pipegap[p * n + i];
+    }
+    S_BatchCollide(n, scroll, batch->nearx, batch->neary, batch->neargap,
+                   birdy, alive, batch->score);
+
+    for (uint i = 0; i < n; i++) {
+        numalive += alive[i];
+    }
+    return numalive;
+}
+
+static void S_BatchScroll(uint n, int scroll, int *restrict pipex,
+                          const Uint8 *restrict alive) {
+    for (uint i = 0; i < n; i++) {
+        pipex[i] -= alive[i] * scroll;
+    }
+}
+
+// Tests every lane's nearest pipe against its bird. This is U_IsColliding()
+// for the top, bottom and middle rects with the comparisons combined bitwise
+// so the loop has no branches.
+static void S_BatchCollide(uint n, int scroll, const int *restrict nearx,
+                           const int *restrict neary,
+                           const int *restrict neargap,
+                           const int *restrict birdy, Uint8 *restrict alive,
+                           int *restrict score) {
+    const int bx = SIM_BIRD_X;
+    const int bsize = SIM_BIRD_SIZE;
+    for (uint i = 0; i < n; i++) {
+        const int move = alive[i] * scroll;
+        const int x = nearx[i];
+        const int y = birdy[i];
+        const int top = neary[i] - neargap[i];
+        const int bottom = neary[i] + neargap[i];
+        const int mx = x + (SIM_PIPE_WIDTH / 2);
+        const int xover = (bx < x + SIM_PIPE_WIDTH) & (bx + bsize > x);
+        const int collided = xover &
+            (((y < top) & (y + bsize > top - SIM_PIPE_HEIGHT)) |
+             ((y < bottom + SIM_PIPE_HEIGHT) & (y + bsize > bottom)));
+        // Middle rect widened by scroll, see S_Play()
+        const int scored = (bx < mx + move + 1) & (bx + bsize > mx) &
+            (y < bottom) & (y + bsize > top) & (bx > mx);
+        score[i] += scored;
+        alive[i] &= !collided;
+    }
+}
+
+static void S_BatchGeneratePipes(SimBatch *batch, uint lane) {
+    const uint n = batch->count;
+    for (uint p = 0; p < SIM_NUM_PIPES; p++) {
+        batch->pipex[p * n + lane] = batch->layout.spacing * (p + 1);
+        batch->pipey[p * n + lane] = S_PipeCenter(&batch->rng[lane]);
+        batch->pipegap[p * n + lane] = batch->layout.gap;
+    }
+    batch->headpipe[lane] = 0;
+    batch->nextpipe[lane] = 0;
+}
+
+// Same as S_RecyclePipe() in s_sim.c for one lane.
+static void S_BatchRecyclePipe(SimBatch *batch, uint lane) {
+    const uint n = batch->count;
+    const uint head = batch->headpipe[lane];
+    const uint tail = (head + SIM_NUM_PIPES - 1) % SIM_NUM_PIPES;
+    int spacing, gap;
+
+    S_LayoutAt(&batch->layout, batch->score[lane], &spacing, &gap);
+    batch->pipex[head * n + lane] = batch->pipex[tail * n + lane] + spacing;
+    batch->pipey[head * n + lane] = S_PipeCenter(&batch->rng[lane]);
+    batch->pipegap[head * n + lane] = gap;
+    batch->headpipe[lane] = (Uint8)((head + 1) % SIM_NUM_PIPES);
+}
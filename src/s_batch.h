@@ -0,0 +1,68 @@
+/* =============================================================================
+** FlappyBirby, file: s_batch.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_BATCH_H__
+#define __S_BATCH_H__
+
+#include "s_sim.h"
+
+// Many independent games stored as struct-of-arrays so one S_BatchStep()
+// advances every lane with loops the compiler can vectorize. Lanes start in
+// STATE_PLAY and stay dead once they collide until S_BatchResetLane().
+// Pipe arrays are laid out pipe-major: pipex[pipe * count + lane]. Each lane
+// recycles its pipes as a ring the same way SimState does, so going around
+// from headpipe they are sorted by x and only the nearest one gets tested.
+typedef struct {
+    uint count;
+    uint tickrate;
+    uint movefrac; // shared, all lanes step in lockstep
+    SimLayout layout;
+    Uint64 seed;
+    // Lane i plays run i of the seed first and every S_BatchResetLane()
+    // moves it count runs on, so its pipes are the ones S_Reset() gives a
+    // SimState on that run and no two lanes ever share a stream
+    uint *run;
+    RandomState *rng;
+    int *birdy;
+    int *pipex;
+    int *pipey;
+    int *pipegap;
+    int *groundx;
+    int *score;
+    Uint8 *alive;
+    Uint8 *headpipe;
+    Uint8 *nextpipe; // first pipe whose right edge is still past the bird
+    int *nearx; // scratch, the nearest pipe of every lane
+    int *neary;
+    int *neargap;
+} SimBatch;
+
+boolean S_BatchCreate(SimBatch *batch, uint count, uint tickrate,
+                      const SimLayout *layout, Uint64 seed);
+void S_BatchDestroy(SimBatch *batch);
+void S_BatchReset(SimBatch *batch);
+void S_BatchResetLane(SimBatch *batch, uint lane);
+uint S_BatchStep(SimBatch *batch, const Uint8 *flaps);
+
+#endif
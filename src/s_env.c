@@ -0,0 +1,176 @@
+/* =============================================================================
+** FlappyBirby, file: s_env.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_env.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void S_EnvObserve(SimEnv *env, void *obs);
+static void S_EnvRenderLane(void *data, uint lane);
+
+// downsample and pakpath only matter for ENV_OBS_PIXELS: without a bundle
+// the frames are drawn in flat shades. numthreads renders frames on a Pool,
+// 0 for one thread per core. NULL if anything can't be set up.
+SimEnv *S_EnvCreate(uint count, Uint64 seed, int obstype, int downsample,
+                    const char *pakpath, uint numthreads) {
+    SimEnv *env = calloc(1, sizeof(SimEnv));
+    if (env == NULL)
+        return NULL;
+    env->obstype = obstype;
+    if (!S_BatchCreate(&env->batch, count, SIM_TICK_RATE, NULL, seed)) {
+        free(env);
+        return NULL;
+    }
+    env->prevscore = malloc(count * sizeof(int));
+    if (env->prevscore == NULL) {
+        S_EnvDestroy(env);
+        return NULL;
+    }
+    if (obstype == ENV_OBS_PIXELS) {
+        env->haspak = pakpath != NULL && A_PakOpen(&env->pak, pakpath);
+        if (!R_SoftInit(&env->raster, env->haspak ? &env->pak : NULL,
+                        downsample)) {
+            S_EnvDestroy(env);
+            return NULL;
+        }
+        if (numthreads != 1) {
+            env->haspool = U_PoolCreate(&env->pool, numthreads);
+        }
+    }
+    return env;
+}
+
+void S_EnvDestroy(SimEnv *env) {
+    if (env == NULL)
+        return;
+    if (env->haspool) {
+        U_PoolDestroy(&env->pool);
+    }
+    R_SoftFree(&env->raster);
+    if (env->haspak) {
+        A_PakClose(&env->pak);
+    }
+    S_BatchDestroy(&env->batch);
+    free(env->prevscore);
+    free(env);
+}
+
+// Bytes of observation per lane.
+uint S_EnvObsSize(const SimEnv *env) {
+    if (env->obstype == ENV_OBS_PIXELS)
+        return (uint)(env->raster.width * env->raster.height);
+    return ENV_NUM_FEATURES * sizeof(float);
+}
+
+void S_EnvFrameSize(const SimEnv *env, int *width, int *height) {
+    *width = env->raster.width;
+    *height = env->raster.height;
+}
+
+// Starts every lane over on the pipes of seed, obs may be NULL.
+void S_EnvReset(SimEnv *env, Uint64 seed, void *obs) {
+    env->batch.seed = seed;
+    env->batch.movefrac = 0;
+    S_BatchReset(&env->batch);
+    if (obs != NULL) {
+        S_EnvObserve(env, obs);
+    }
+}
+
+// actions holds a flap flag per lane. Returns how many lanes died.
+uint S_EnvStep(SimEnv *env, const Uint8 *actions, void *obs, float *rewards,
+               Uint8 *dones) {
+    SimBatch *batch = &env->batch;
+    uint numdone = 0;
+    memcpy(env->prevscore, batch->score, batch->count * sizeof(int));
+    S_BatchStep(batch, actions);
+    for (uint i = 0; i < batch->count; i++) {
+        const int died = !batch->alive[i];
+        rewards[i] = (float)(batch->score[i] - env->prevscore[i] - died);
+        dones[i] = (Uint8)died;
+        if (died) {
+            S_BatchResetLane(batch, i);
+            numdone++;
+        }
+    }
+    S_EnvObserve(env, obs);
+    return numdone;
+}
+
+static void S_EnvObserve(SimEnv *env, void *obs) {
+    const SimBatch *batch = &env->batch;
+    const uint n = batch->count;
+    if (env->obstype == ENV_OBS_PIXELS) {
+        env->frames = obs;
+        if (env->haspool) {
+            U_PoolRun(&env->pool, S_EnvRenderLane, env, n);
+        } else {
+            for (uint i = 0; i < n; i++) {
+                S_EnvRenderLane(env, i);
+            }
+        }
+        return;
+    }
+    float *features = obs;
+    for (uint i = 0; i < n; i++) {
+        const uint p = batch->nextpipe[i] * n + i;
+        features[0] = batch->birdy[i] / (float)SIM_HEIGHT;
+        features[1] = (batch->pipex[p] - SIM_BIRD_X) / (float)SIM_WIDTH;
+        features[2] = batch->pipey[p] / (float)SIM_HEIGHT;
+        features[3] = batch->pipegap[p] / (float)SIM_HEIGHT;
+        features += ENV_NUM_FEATURES;
+    }
+}
+
+// Draws a lane in the order P_Play() does: background, bird, ground, pipes.
+static void S_EnvRenderLane(void *data, uint lane) {
+    const SimEnv *env = data;
+    const SimBatch *batch = &env->batch;
+    const SoftRaster *raster = &env->raster;
+    const uint n = batch->count;
+    Uint8 *frame = env->frames + (size_t)lane * raster->width * raster->height;
+
+    R_SoftClear(raster, frame);
+    const SDL_Rect bird = {
+        SIM_BIRD_X, batch->birdy[lane], SIM_BIRD_SIZE, SIM_BIRD_SIZE,
+    };
+    R_SoftSprite(raster, frame, SOFT_BIRD, &bird, false);
+    const SDL_Rect ground = {
+        batch->groundx[lane], 0, SIM_WIDTH * 2, SIM_HEIGHT,
+    };
+    R_SoftSprite(raster, frame, SOFT_GROUND, &ground, false);
+    for (uint p = 0; p < SIM_NUM_PIPES; p++) {
+        const SDL_Rect pipe = {
+            batch->pipex[p * n + lane], batch->pipey[p * n + lane], 0,
+            batch->pipegap[p * n + lane],
+        };
+        SDL_Rect top, bottom, middle;
+        if (pipe.x >= SIM_WIDTH || pipe.x + SIM_PIPE_WIDTH <= 0)
+            continue;
+        S_PipeRects(&pipe, &top, &bottom, &middle);
+        R_SoftSprite(raster, frame, SOFT_PIPE, &top, true);
+        R_SoftSprite(raster, frame, SOFT_PIPE, &bottom, false);
+    }
+}
@@ -0,0 +1,71 @@
+/* =============================================================================
+** FlappyBirby, file: s_env.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_ENV_H__
+#define __S_ENV_H__
+
+#include "s_batch.h"
+#include "r_soft.h"
+#include "u_pool.h"
+
+// Training environment over a SimBatch, the API of libflappybirby.so. One
+// S_EnvStep() is one tick of every lane. Observations, rewards and done
+// flags are written straight into the caller's buffers (numpy arrays from
+// Python), lane after lane:
+//   ENV_OBS_FEATURES  float[ENV_NUM_FEATURES] per lane: bird y, next pipe x
+//                     relative to the bird, gap center and half gap, all
+//                     divided by the screen size
+//   ENV_OBS_PIXELS    Uint8 width * height per lane, a grayscale frame
+//                     downsampled by an integer factor, see S_EnvFrameSize()
+// Reward is 1 for every pipe passed and -1 on death. Lanes that die are
+// reset right away, so the observation after a done is the new game's.
+#define ENV_NUM_FEATURES 4
+
+typedef enum {
+    ENV_OBS_FEATURES = 0,
+    ENV_OBS_PIXELS,
+} EnvObs;
+
+typedef struct {
+    SimBatch batch;
+    int obstype;
+    int *prevscore;
+    Pak pak;
+    boolean haspak;
+    SoftRaster raster;
+    Pool pool;
+    boolean haspool;
+    Uint8 *frames; // where the pool renders to during S_EnvStep()
+} SimEnv;
+
+SimEnv *S_EnvCreate(uint count, Uint64 seed, int obstype, int downsample,
+                    const char *pakpath, uint numthreads);
+void S_EnvDestroy(SimEnv *env);
+uint S_EnvObsSize(const SimEnv *env);
+void S_EnvFrameSize(const SimEnv *env, int *width, int *height);
+void S_EnvReset(SimEnv *env, Uint64 seed, void *obs);
+uint S_EnvStep(SimEnv *env, const Uint8 *actions, void *obs, float *rewards,
+               Uint8 *dones);
+
+#endif
@@ -0,0 +1,220 @@
+/* =============================================================================
+** FlappyBirby, file: s_ghost.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_ghost.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static boolean S_GhostReserve(GhostSet *ghosts, uint numflaps);
+static void S_GhostAppend(GhostSet *ghosts, uint numflaps, uint deathtick);
+static void S_GhostResetLane(GhostSet *ghosts, uint i);
+static void S_GhostStep(GhostSet *ghosts);
+static void S_GhostForget(GhostSet *ghosts);
+static void S_GhostSave(GhostSet *ghosts);
+static boolean S_GhostRestore(GhostSet *ghosts, uint tick);
+
+#define GHOST_NO_CHECKPOINT 0xFFFFFFFF
+
+boolean S_GhostCreate(GhostSet *ghosts, uint capacity, uint tickrate) {
+    memset(ghosts, 0, sizeof(*ghosts));
+    ghosts->capacity = capacity;
+    ghosts->tickrate = tickrate;
+    ghosts->birdy = malloc(capacity * sizeof(int));
+    ghosts->deathtick = malloc(capacity * sizeof(Uint32));
+    ghosts->next = malloc(capacity * sizeof(Uint32));
+    ghosts->end = malloc(capacity * sizeof(Uint32));
+    ghosts->first = malloc(capacity * sizeof(Uint32));
+    ghosts->phase = malloc(capacity);
+    ghosts->savedy = malloc((size_t)capacity * GHOST_CHECKPOINTS * sizeof(int));
+    ghosts->savednext = malloc((size_t)capacity * GHOST_CHECKPOINTS *
+                               sizeof(Uint32));
+    if (ghosts->birdy == NULL || ghosts->deathtick == NULL ||
+        ghosts->next == NULL || ghosts->end == NULL || ghosts->first == NULL ||
+        ghosts->phase == NULL || ghosts->savedy == NULL ||
+        ghosts->savednext == NULL) {
+        S_GhostDestroy(ghosts);
+        return false;
+    }
+    S_GhostForget(ghosts);
+    return true;
+}
+
+void S_GhostDestroy(GhostSet *ghosts) {
+    free(ghosts->birdy);
+    free(ghosts->deathtick);
+    free(ghosts->next);
+    free(ghosts->end);
+    free(ghosts->first);
+    free(ghosts->phase);
+    free(ghosts->flaps);
+    free(ghosts->savedy);
+    free(ghosts->savednext);
+    memset(ghosts, 0, sizeof(*ghosts));
+}
+
+// ticks as counted by SimState.tick, ascending. Ghosts are added on the
+// start screen, before the set is first seeked.
+boolean S_GhostAdd(GhostSet *ghosts, const Uint32 *ticks, uint numflaps,
+                   uint deathtick) {
+    if (ghosts->count == ghosts->capacity ||
+        !S_GhostReserve(ghosts, numflaps))
+        return false;
+    memcpy(&ghosts->flaps[ghosts->numflaps], ticks, numflaps * sizeof(Uint32));
+    S_GhostAppend(ghosts, numflaps, deathtick);
+    return true;
+}
+
+// False when the set is full, the replay was played at another tick rate or
+// out of memory. The flaps are decoded straight into the set.
+boolean S_GhostAddReplay(GhostSet *ghosts, const Replay *replay) {
+    if (ghosts->count == ghosts->capacity ||
+        replay->tickrate != ghosts->tickrate ||
+        !S_GhostReserve(ghosts, replay->numflaps))
+        return false;
+    const uint numflaps = S_ReplayTicks(replay,
+        &ghosts->flaps[ghosts->numflaps], replay->numflaps);
+    S_GhostAppend(ghosts, numflaps, replay->deathtick);
+    return true;
+}
+
+// Back to the start screen, every ghost waiting on its starting flap.
+void S_GhostReset(GhostSet *ghosts) {
+    ghosts->movefrac = 0;
+    ghosts->tick = 0;
+    for (uint i = 0; i < ghosts->count; i++) {
+        S_GhostResetLane(ghosts, i);
+    }
+}
+
+// Brings the ghosts to the player's tick. Going back resumes from the
+// nearest checkpoint at or before tick, from the start when there is none.
+void S_GhostSeek(GhostSet *ghosts, uint tick) {
+    if (tick < ghosts->tick && !S_GhostRestore(ghosts, tick)) {
+        S_GhostReset(ghosts);
+    }
+    while (ghosts->tick < tick) {
+        S_GhostStep(ghosts);
+        if (ghosts->tick % GHOST_CHECKPOINT_TICKS == 0) {
+            S_GhostSave(ghosts);
+        }
+    }
+}
+
+static boolean S_GhostReserve(GhostSet *ghosts, uint numflaps) {
+    if (ghosts->numflaps + numflaps <= ghosts->flapcapacity)
+        return true;
+    uint capacity = ghosts->flapcapacity > 0 ? ghosts->flapcapacity : 1024;
+    while (capacity < ghosts->numflaps + numflaps) {
+        capacity *= 2;
+    }
+    Uint32 *flaps = realloc(ghosts->flaps, capacity * sizeof(Uint32));
+    if (flaps == NULL)
+        return false;
+    ghosts->flaps = flaps;
+    ghosts->flapcapacity = capacity;
+    return true;
+}
+
+// A new lane for the numflaps ticks already written after the last one.
+static void S_GhostAppend(GhostSet *ghosts, uint numflaps, uint deathtick) {
+    const uint i = ghosts->count++;
+    ghosts->first[i] = ghosts->numflaps;
+    ghosts->numflaps += numflaps;
+    ghosts->end[i] = ghosts->numflaps;
+    ghosts->deathtick[i] = deathtick;
+    ghosts->phase[i] = (Uint8)(i % GHOST_NUM_PHASES);
+    S_GhostResetLane(ghosts, i);
+    S_GhostForget(ghosts); // they don't have the new lane
+}
+
+static void S_GhostResetLane(GhostSet *ghosts, uint i) {
+    ghosts->birdy[i] = SIM_BIRD_Y;
+    uint next = ghosts->first[i];
+    // The flap on tick 0 starts the run, it doesn't move the bird
+    while (next < ghosts->end[i] && ghosts->flaps[next] == 0) {
+        next++;
+    }
+    ghosts->next[i] = next;
+}
+
+// The motion part of S_Play() for every ghost.
+static void S_GhostStep(GhostSet *ghosts) {
+    const int scroll = S_Advance(&ghosts->movefrac, ghosts->tickrate);
+    const Uint32 tick = ++ghosts->tick;
+    const int bottom = SIM_HEIGHT - (SIM_BIRD_SIZE / 2);
+    for (uint i = 0; i < ghosts->count; i++) {
+        int y = ghosts->birdy[i];
+        const Uint32 next = ghosts->next[i];
+        if (next < ghosts->end[i] && ghosts->flaps[next] == tick) {
+            y -= SIM_FLAP_HEIGHT;
+            ghosts->next[i] = next + 1;
+        }
+        y += scroll;
+        if (y >= bottom) {
+            y = bottom;
+        }
+        ghosts->birdy[i] = y;
+    }
+}
+
+static void S_GhostForget(GhostSet *ghosts) {
+    for (uint k = 0; k < GHOST_CHECKPOINTS; k++) {
+        ghosts->savedtick[k] = GHOST_NO_CHECKPOINT;
+    }
+}
+
+// A ghost's motion depends on nothing but the tick, so a checkpoint stays
+// good until a lane is added.
+static void S_GhostSave(GhostSet *ghosts) {
+    const uint k = ghosts->tick / GHOST_CHECKPOINT_TICKS % GHOST_CHECKPOINTS;
+    if (ghosts->savedtick[k] == ghosts->tick)
+        return;
+    const size_t slot = (size_t)k * ghosts->capacity;
+    memcpy(&ghosts->savedy[slot], ghosts->birdy, ghosts->count * sizeof(int));
+    memcpy(&ghosts->savednext[slot], ghosts->next,
+           ghosts->count * sizeof(Uint32));
+    ghosts->savedtick[k] = ghosts->tick;
+    ghosts->savedfrac[k] = ghosts->movefrac;
+}
+
+// False when no checkpoint at or before tick is kept.
+static boolean S_GhostRestore(GhostSet *ghosts, uint tick) {
+    Uint32 at = tick - tick % GHOST_CHECKPOINT_TICKS;
+    for (uint n = 0; n < GHOST_CHECKPOINTS && at > 0; n++) {
+        const uint k = at / GHOST_CHECKPOINT_TICKS % GHOST_CHECKPOINTS;
+        if (ghosts->savedtick[k] == at) {
+            const size_t slot = (size_t)k * ghosts->capacity;
+            memcpy(ghosts->birdy, &ghosts->savedy[slot],
+                   ghosts->count * sizeof(int));
+            memcpy(ghosts->next, &ghosts->savednext[slot],
+                   ghosts->count * sizeof(Uint32));
+            ghosts->tick = at;
+            ghosts->movefrac = ghosts->savedfrac[k];
+            return true;
+        }
+        at -= GHOST_CHECKPOINT_TICKS;
+    }
+    return false;
+}
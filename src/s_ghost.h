@@ -0,0 +1,71 @@
+/* =============================================================================
+** FlappyBirby, file: s_ghost.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_GHOST_H__
+#define __S_GHOST_H__
+
+#include "s_replay.h"
+
+#define GHOST_NUM_PHASES 4 // animation offsets so they don't all beat at once
+// A seek back replays at most GHOST_CHECKPOINT_TICKS ticks when it lands
+// within the last GHOST_CHECKPOINTS checkpoints, about 8 s at 120 ticks
+#define GHOST_CHECKPOINTS 32
+#define GHOST_CHECKPOINT_TICKS 32
+
+// Birds of recorded runs raced alongside the player, struct-of-arrays like
+// SimBatch. A ghost needs nothing but its flap ticks: the bird moves the
+// same whatever the pipes are, and the tick it died on is in its replay.
+// All of them start on the flap that starts the player's run.
+typedef struct {
+    uint count;
+    uint capacity;
+    uint tickrate; // of every ghost, the player's
+    uint movefrac;
+    uint tick; // S_Step() ticks played, like SimState.tick
+    int *birdy;
+    Uint32 *deathtick; // shown up to and including this tick
+    Uint32 *next; // index of the next flap in flaps
+    Uint32 *end; // one past the last flap
+    Uint32 *first;
+    Uint8 *phase;
+    Uint32 *flaps; // the flap ticks of every ghost, one after the other
+    uint numflaps;
+    uint flapcapacity;
+    // Checkpoint k holds every lane's birdy and next at savedtick[k], a
+    // multiple of GHOST_CHECKPOINT_TICKS, in slot k of capacity entries
+    int *savedy;
+    Uint32 *savednext;
+    Uint32 savedtick[GHOST_CHECKPOINTS];
+    uint savedfrac[GHOST_CHECKPOINTS];
+} GhostSet;
+
+boolean S_GhostCreate(GhostSet *ghosts, uint capacity, uint tickrate);
+void S_GhostDestroy(GhostSet *ghosts);
+boolean S_GhostAdd(GhostSet *ghosts, const Uint32 *ticks, uint numflaps,
+                   uint deathtick);
+boolean S_GhostAddReplay(GhostSet *ghosts, const Replay *replay);
+void S_GhostReset(GhostSet *ghosts);
+void S_GhostSeek(GhostSet *ghosts, uint tick);
+
+#endif
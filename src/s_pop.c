@@ -0,0 +1,88 @@
+/* =============================================================================
+** FlappyBirby, file: s_pop.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_pop.h"
+
+typedef struct {
+    const PopConfig *config;
+    const Controller *controllers;
+    Fitness *fitness;
+} PopJob;
+
+static void S_PopTask(void *data, uint index);
+
+// Flaps when the weighted sum of the bird's offset from the gap center,
+// the distance to the pipe, the gap size and a bias is positive.
+boolean S_ControllerFlap(const Controller *controller, const SimState *sim) {
+    if (sim->state != STATE_PLAY)
+        return sim->state == STATE_START;
+    if (sim->tick % POP_DECIDE_TICKS != 0)
+        return false;
+    const SDL_Rect *pipe = &sim->pipes[sim->headpipe];
+    for (uint k = 0; k < SIM_NUM_PIPES; k++) {
+        pipe = &sim->pipes[(sim->headpipe + k) % SIM_NUM_PIPES];
+        if (pipe->x + SIM_PIPE_WIDTH > sim->bird.x)
+            break;
+    }
+    const float features[POP_NUM_WEIGHTS] = {
+        (sim->bird.y + SIM_BIRD_SIZE / 2 - pipe->y) / 100.0f,
+        (pipe->x - sim->bird.x) / 100.0f,
+        pipe->h / 100.0f,
+        1.0f,
+    };
+    float sum = 0.0f;
+    for (uint i = 0; i < POP_NUM_WEIGHTS; i++) {
+        sum += controller->weights[i] * features[i];
+    }
+    return sum > 0.0f;
+}
+
+// Plays one game per controller on the pool and fills in its fitness. The
+// results do not depend on the number of threads.
+void S_PopEvaluate(Pool *pool, const PopConfig *config,
+                   const Controller *controllers, Fitness *fitness,
+                   uint count) {
+    PopJob job;
+    job.config = config;
+    job.controllers = controllers;
+    job.fitness = fitness;
+    U_PoolRun(pool, S_PopTask, &job, count);
+}
+
+static void S_PopTask(void *data, uint index) {
+    const PopJob *job = data;
+    const Controller *controller = &job->controllers[index];
+    SimState sim;
+    SimInput input;
+
+    S_Init(&sim, job->config->tickrate, &job->config->layout,
+           job->config->seed);
+    while (sim.tick < job->config->maxticks) {
+        input.flap = S_ControllerFlap(controller, &sim);
+        if (S_Step(&sim, &input) & SIM_EVENT_DEATH)
+            break;
+    }
+    job->fitness[index].score = sim.score;
+    job->fitness[index].ticks = sim.tick;
+}
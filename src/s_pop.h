@@ -0,0 +1,59 @@
+/* =============================================================================
+** FlappyBirby, file: s_pop.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_POP_H__
+#define __S_POP_H__
+
+#include "s_sim.h"
+#include "u_pool.h"
+
+// Autopilot controllers evaluated a whole generation at a time, one game
+// per controller spread over a Pool. A controller is a linear policy over a
+// few features of the nearest pipe, looked at every POP_DECIDE_TICKS ticks.
+#define POP_NUM_WEIGHTS 4
+#define POP_DECIDE_TICKS 4
+
+typedef struct {
+    float weights[POP_NUM_WEIGHTS];
+} Controller;
+
+typedef struct {
+    int score;
+    uint ticks; // survived, at most the maxticks evaluated for
+} Fitness;
+
+// The same pipes for every controller of a generation
+typedef struct {
+    uint tickrate;
+    SimLayout layout;
+    Uint64 seed;
+    uint maxticks;
+} PopConfig;
+
+boolean S_ControllerFlap(const Controller *controller, const SimState *sim);
+void S_PopEvaluate(Pool *pool, const PopConfig *config,
+                   const Controller *controllers, Fitness *fitness,
+                   uint count);
+
+#endif
@@ -0,0 +1,289 @@
+/* =============================================================================
+** FlappyBirby, file: s_replay.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_replay.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_HEADER_SIZE 52
+
+static boolean S_ReplayPutByte(Replay *replay, Uint8 byte);
+static boolean S_ReplayNext(ReplayCursor *cursor);
+static Uint8 *S_Put32(Uint8 *p, Uint32 value);
+static const Uint8 *S_Get32(const Uint8 *p, Uint32 *value);
+
+// Call on SIM_EVENT_START, the starting flap itself goes in through
+// S_ReplayFlap() like every other one.
+void S_ReplayBegin(Replay *replay, const SimState *sim) {
+    replay->tickrate = sim->tickrate;
+    replay->layout = sim->layout;
+    replay->seed = sim->seed;
+    replay->run = sim->run;
+    replay->score = 0;
+    replay->deathtick = 0;
+    replay->numflaps = 0;
+    replay->size = 0;
+    replay->lasttick = 0;
+}
+
+boolean S_ReplayFlap(Replay *replay, uint tick) {
+    Uint32 delta = tick - replay->lasttick;
+    do {
+        Uint8 byte = delta & 0x7F;
+        delta >>= 7;
+        if (delta != 0)
+            byte |= 0x80;
+        if (!S_ReplayPutByte(replay, byte))
+            return false;
+    } while (delta != 0);
+    replay->lasttick = tick;
+    replay->numflaps++;
+    return true;
+}
+
+// Call on SIM_EVENT_DEATH.
+void S_ReplayEnd(Replay *replay, const SimState *sim) {
+    replay->score = sim->score;
+    replay->deathtick = sim->tick;
+}
+
+// Forgets the flaps after tick, for a run that was rewound to a snapshot
+// taken on that tick. What gets recorded from there on plays back as is.
+void S_ReplayRewind(Replay *replay, uint tick) {
+    ReplayCursor cursor;
+    cursor.replay = replay;
+    cursor.pos = 0;
+    cursor.nexttick = 0;
+    uint numflaps = 0;
+    size_t size = 0;
+    uint lasttick = 0;
+    while (numflaps < replay->numflaps && S_ReplayNext(&cursor) &&
+           cursor.nexttick <= tick) {
+        numflaps++;
+        size = cursor.pos;
+        lasttick = cursor.nexttick;
+    }
+    replay->numflaps = numflaps;
+    replay->size = size;
+    replay->lasttick = lasttick;
+    replay->score = 0;
+    replay->deathtick = 0;
+}
+
+// Decodes up to maxticks flap ticks, returns how many there were.
+uint S_ReplayTicks(const Replay *replay, Uint32 *ticks, uint maxticks) {
+    ReplayCursor cursor;
+    cursor.replay = replay;
+    cursor.pos = 0;
+    cursor.nexttick = 0;
+    uint numticks = 0;
+    while (numticks < replay->numflaps && numticks < maxticks &&
+           S_ReplayNext(&cursor)) {
+        ticks[numticks++] = cursor.nexttick;
+    }
+    return numticks;
+}
+
+boolean S_ReplaySave(const Replay *replay, const char *path) {
+    FILE *handle = fopen(path, "wb");
+    if (handle == NULL)
+        return false;
+    boolean ok = S_ReplayWrite(replay, handle);
+    if (fclose(handle) != 0)
+        ok = false;
+    return ok;
+}
+
+boolean S_ReplayLoad(Replay *replay, const char *path) {
+    FILE *handle = fopen(path, "rb");
+    if (handle == NULL) {
+        memset(replay, 0, sizeof(*replay));
+        return false;
+    }
+    const boolean ok = S_ReplayRead(replay, handle);
+    fclose(handle);
+    return ok;
+}
+
+// At the current position of handle, so replays can follow one another
+// in one file.
+boolean S_ReplayWrite(const Replay *replay, FILE *handle) {
+    Uint8 header[REPLAY_HEADER_SIZE];
+    Uint8 *p = header;
+    p = S_Put32(p, REPLAY_MAGIC);
+    p = S_Put32(p, REPLAY_VERSION);
+    p = S_Put32(p, replay->tickrate);
+    p = S_Put32(p, (Uint32)replay->layout.spacing);
+    p = S_Put32(p, (Uint32)replay->layout.gap);
+    p = S_Put32(p, replay->layout.rampscore);
+    p = S_Put32(p, (Uint32)replay->seed);
+    p = S_Put32(p, (Uint32)(replay->seed >> 32));
+    p = S_Put32(p, replay->run);
+    p = S_Put32(p, (Uint32)replay->score);
+    p = S_Put32(p, replay->deathtick);
+    p = S_Put32(p, replay->numflaps);
+    p = S_Put32(p, (Uint32)replay->size);
+    return fwrite(header, 1, sizeof(header), handle) == sizeof(header) &&
+        fwrite(replay->data, 1, replay->size, handle) == replay->size;
+}
+
+boolean S_ReplayRead(Replay *replay, FILE *handle) {
+    Uint8 header[REPLAY_HEADER_SIZE];
+    Uint32 magic, version, spacing, gap, seedlo, seedhi, score, size;
+    memset(replay, 0, sizeof(*replay));
+
+    if (fread(header, 1, sizeof(header), handle) != sizeof(header))
+        return false;
+    const Uint8 *p = header;
+    p = S_Get32(p, &magic);
+    p = S_Get32(p, &version);
+    p = S_Get32(p, &replay->tickrate);
+    p = S_Get32(p, &spacing);
+    p = S_Get32(p, &gap);
+    p = S_Get32(p, &replay->layout.rampscore);
+    p = S_Get32(p, &seedlo);
+    p = S_Get32(p, &seedhi);
+    p = S_Get32(p, &replay->run);
+    p = S_Get32(p, &score);
+    p = S_Get32(p, &replay->deathtick);
+    p = S_Get32(p, &replay->numflaps);
+    p = S_Get32(p, &size);
+    if (magic != REPLAY_MAGIC || version != REPLAY_VERSION ||
+        replay->tickrate == 0 || size < replay->numflaps)
+        return false;
+    replay->layout.spacing = (int)spacing;
+    replay->layout.gap = (int)gap;
+    replay->seed = ((Uint64)seedhi << 32) | seedlo;
+    replay->score = (int)score;
+
+    replay->data = malloc(size > 0 ? size : 1);
+    if (replay->data == NULL ||
+        fread(replay->data, 1, size, handle) != size) {
+        S_ReplayFree(replay);
+        return false;
+    }
+    replay->size = replay->capacity = size;
+    return true;
+}
+
+void S_ReplayFree(Replay *replay) {
+    free(replay->data);
+    replay->data = NULL;
+    replay->size = replay->capacity = 0;
+}
+
+// Sets sim up the way the recorded run started.
+void S_ReplayStart(ReplayCursor *cursor, const Replay *replay, SimState *sim) {
+    S_Init(sim, replay->tickrate, &replay->layout, replay->seed);
+    sim->run = replay->run;
+    S_Reset(sim);
+    cursor->replay = replay;
+    cursor->pos = 0;
+    cursor->flapsleft = replay->numflaps;
+    cursor->nexttick = 0;
+    if (!S_ReplayNext(cursor)) {
+        cursor->flapsleft = 0;
+    }
+}
+
+// Fills in the input for the next S_Step() on sim.
+void S_ReplayInput(ReplayCursor *cursor, const SimState *sim, SimInput *input) {
+    input->flap = false;
+    if (cursor->flapsleft == 0 || sim->state == STATE_OVER)
+        return;
+    const uint tick = sim->state == STATE_START ? 0 : sim->tick + 1;
+    if (tick == cursor->nexttick) {
+        input->flap = true;
+        if (--cursor->flapsleft > 0 && !S_ReplayNext(cursor)) {
+            cursor->flapsleft = 0;
+        }
+    }
+}
+
+// Plays the replay headless as fast as possible. True when the run ends
+// with the recorded score on the recorded tick.
+boolean S_ReplayVerify(const Replay *replay, int *score, uint *deathtick) {
+    SimState sim;
+    ReplayCursor cursor;
+    SimInput input;
+    S_ReplayStart(&cursor, replay, &sim);
+    for (;;) {
+        S_ReplayInput(&cursor, &sim, &input);
+        const uint events = S_Step(&sim, &input);
+        if ((events & SIM_EVENT_DEATH) || sim.state == STATE_START ||
+            sim.tick > replay->deathtick)
+            break;
+    }
+    *score = sim.score;
+    *deathtick = sim.tick;
+    return sim.state == STATE_OVER && sim.score == replay->score &&
+        sim.tick == replay->deathtick;
+}
+
+static boolean S_ReplayPutByte(Replay *replay, Uint8 byte) {
+    if (replay->size == replay->capacity) {
+        const size_t capacity = replay->capacity > 0 ?
+            replay->capacity * 2 : 256;
+        Uint8 *data = realloc(replay->data, capacity);
+        if (data == NULL)
+            return false;
+        replay->data = data;
+        replay->capacity = capacity;
+    }
+    replay->data[replay->size++] = byte;
+    return true;
+}
+
+// Decodes the next delta into cursor->nexttick.
+static boolean S_ReplayNext(ReplayCursor *cursor) {
+    const Replay *replay = cursor->replay;
+    Uint32 delta = 0;
+    for (uint shift = 0; shift < 32; shift += 7) {
+        if (cursor->pos >= replay->size)
+            return false;
+        const Uint8 byte = replay->data[cursor->pos++];
+        delta |= (Uint32)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            cursor->nexttick += delta;
+            return true;
+        }
+    }
+    return false;
+}
+
+static Uint8 *S_Put32(Uint8 *p, Uint32 value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = (value >> 24) & 0xFF;
+    return p + 4;
+}
+
+static const Uint8 *S_Get32(const Uint8 *p, Uint32 *value) {
+    *value = (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) |
+        ((Uint32)p[3] << 24);
+    return p + 4;
+}
@@ -0,0 +1,74 @@
+/* =============================================================================
+** FlappyBirby, file: s_replay.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_REPLAY_H__
+#define __S_REPLAY_H__
+
+#include <stdio.h>
+
+#include "s_sim.h"
+
+#define REPLAY_MAGIC 0x50524246 // "FBRP" little endian
+#define REPLAY_VERSION 1
+
+// One run: the settings it was played with, its result and the tick of every
+// flap counted by SimState.tick, the flap that started the run being tick 0.
+// Ticks are stored as LEB128 deltas, so a flap takes a byte or two.
+typedef struct {
+    uint tickrate;
+    SimLayout layout;
+    Uint64 seed;
+    uint run;
+    int score;
+    uint deathtick;
+    uint numflaps;
+    Uint8 *data;
+    size_t size;
+    size_t capacity;
+    uint lasttick; // while recording
+} Replay;
+
+// Reads a Replay back one S_Step() at a time.
+typedef struct {
+    const Replay *replay;
+    size_t pos;
+    uint flapsleft;
+    uint nexttick;
+} ReplayCursor;
+
+void S_ReplayBegin(Replay *replay, const SimState *sim);
+boolean S_ReplayFlap(Replay *replay, uint tick);
+void S_ReplayEnd(Replay *replay, const SimState *sim);
+void S_ReplayRewind(Replay *replay, uint tick);
+uint S_ReplayTicks(const Replay *replay, Uint32 *ticks, uint maxticks);
+boolean S_ReplaySave(const Replay *replay, const char *path);
+boolean S_ReplayLoad(Replay *replay, const char *path);
+boolean S_ReplayWrite(const Replay *replay, FILE *handle);
+boolean S_ReplayRead(Replay *replay, FILE *handle);
+void S_ReplayFree(Replay *replay);
+void S_ReplayStart(ReplayCursor *cursor, const Replay *replay, SimState *sim);
+void S_ReplayInput(ReplayCursor *cursor, const SimState *sim, SimInput *input);
+boolean S_ReplayVerify(const Replay *replay, int *score, uint *deathtick);
+
+#endif
@@ -0,0 +1,381 @@
+/* =============================================================================
+** FlappyBirby, file: s_score.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "s_score.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+typedef struct {
+    ScoreRecord record;
+    Replay replay; // a copy, data is NULL when the run came without one
+} ScoreEntry;
+
+static boolean S_ScoreMap(void);
+static boolean S_ScoreGrow(uint minslots);
+static void S_ScoreUnmap(void);
+static int S_ScoreWriter(void *data);
+static void S_ScoreScan(void);
+static void S_ScoreStore(ScoreEntry *entry);
+static ScoreRecord *S_ScoreSlot(uint slot);
+static Uint32 S_ScoreCheck(const ScoreRecord *record);
+static void S_ScoreRank(ScoreRecord *list, uint *count,
+                        const ScoreRecord *record);
+
+static char storepath[SCORE_PATH_LEN];
+static char replaypath[SCORE_PATH_LEN + 8];
+static ScoreEntry queue[SCORE_QUEUE];
+static SDL_atomic_t queuehead; // next entry S_ScoreAdd() fills
+static SDL_atomic_t queuetail; // next entry the writer stores
+static SDL_atomic_t quit;
+static SDL_atomic_t numruns;
+static SDL_Thread *writer = NULL;
+static SDL_SpinLock toplock;
+static ScoreRecord top[SCORE_TOP]; // best first
+static uint numtop = 0;
+// Only the writer touches these once it runs
+static Uint8 *base = NULL; // the header, then the slots
+static size_t basesize = 0;
+static uint numslots = 0; // base has room for
+static uint nextslot = 0; // after the last one ever written to
+static FILE *replayfile = NULL;
+#ifndef _WIN32
+static int storefd = -1;
+#else
+static FILE *storefile = NULL;
+#endif
+
+// Creates the file if there is none. The records are read back on the
+// writer thread, the best ones show up in S_ScoreTop() once it is done.
+boolean S_ScoreOpen(const char *path) {
+    if (writer != NULL || strlen(path) >= SCORE_PATH_LEN)
+        return false;
+    strcpy(storepath, path);
+    strcpy(replaypath, path);
+    strcat(replaypath, ".replays");
+    if (!S_ScoreMap())
+        return false;
+    replayfile = fopen(replaypath, "ab"); // runs are kept without if NULL
+    numtop = 0;
+    SDL_AtomicSet(&queuehead, 0);
+    SDL_AtomicSet(&queuetail, 0);
+    SDL_AtomicSet(&quit, 0);
+    SDL_AtomicSet(&numruns, 0);
+    writer = SDL_CreateThread(S_ScoreWriter, "ScoreWriter", NULL);
+    if (writer == NULL) {
+        S_ScoreUnmap();
+        return false;
+    }
+    return true;
+}
+
+// Waits for the queued runs to reach the file.
+void S_ScoreClose(void) {
+    if (writer == NULL)
+        return;
+    SDL_AtomicSet(&quit, 1);
+    SDL_WaitThread(writer, NULL);
+    writer = NULL;
+    S_ScoreUnmap();
+}
+
+boolean S_ScoreIsOpen(void) {
+    return writer != NULL;
+}
+
+// Called on the frame, so nothing here waits on the disk or the writer.
+// False when the run was dropped because the writer is that far behind.
+boolean S_ScoreAdd(const SimState *sim, const Replay *replay) {
+    if (writer == NULL)
+        return false;
+    const int head = SDL_AtomicGet(&queuehead);
+    if (head - SDL_AtomicGet(&queuetail) >= SCORE_QUEUE)
+        return false;
+    ScoreEntry *entry = &queue[head & (SCORE_QUEUE - 1)];
+    ScoreRecord *record = &entry->record;
+    memset(record, 0, sizeof(*record));
+    record->score = sim->score;
+    record->deathtick = sim->tick;
+    record->seed = sim->seed;
+    record->run = sim->run;
+    record->tickrate = sim->tickrate;
+    record->timestamp = (Sint64)time(NULL);
+    record->replayoffset = SCORE_NO_REPLAY;
+    memset(&entry->replay, 0, sizeof(entry->replay));
+    if (replay != NULL && replay->size > 0) {
+        entry->replay = *replay;
+        entry->replay.data = malloc(replay->size);
+        if (entry->replay.data != NULL) {
+            memcpy(entry->replay.data, replay->data, replay->size);
+        }
+        entry->replay.capacity = replay->size;
+    }
+    SDL_AtomicLock(&toplock);
+    S_ScoreRank(top, &numtop, record);
+    SDL_AtomicUnlock(&toplock);
+    SDL_AtomicAdd(&numruns, 1);
+    SDL_AtomicSet(&queuehead, head + 1);
+    return true;
+}
+
+// Copies out the best runs, best first, and returns how many there are.
+uint S_ScoreTop(ScoreRecord *records, uint maxrecords) {
+    SDL_AtomicLock(&toplock);
+    const uint count = numtop < maxrecords ? numtop : maxrecords;
+    memcpy(records, top, count * sizeof(ScoreRecord));
+    SDL_AtomicUnlock(&toplock);
+    return count;
+}
+
+// Every run in the file plus the ones added since it was opened.
+uint S_ScoreRuns(void) {
+    return (uint)SDL_AtomicGet(&numruns);
+}
+
+// Opens or creates the file and maps it. Platforms without mmap read it
+// whole and write records back through stdio.
+static boolean S_ScoreMap(void) {
+    size_t size = 0;
+#ifndef _WIN32
+    storefd = open(storepath, O_RDWR | O_CREAT, 0644);
+    if (storefd < 0)
+        return false;
+    struct stat st;
+    if (fstat(storefd, &st) != 0) {
+        S_ScoreUnmap();
+        return false;
+    }
+    size = (size_t)st.st_size;
+#else
+    base = SDL_LoadFile(storepath, &size);
+    storefile = fopen(storepath, base != NULL ? "r+b" : "w+b");
+    if (storefile == NULL) {
+        S_ScoreUnmap();
+        return false;
+    }
+    basesize = base != NULL ? size : 0;
+#endif
+    const boolean created = size < sizeof(ScoreHeader);
+    // Whole slots only, a partly written last one is reused
+    const uint stored = created ? 0 :
+        (uint)((size - sizeof(ScoreHeader)) / sizeof(ScoreRecord));
+    if (!S_ScoreGrow(stored > 0 ? stored : 1)) {
+        S_ScoreUnmap();
+        return false;
+    }
+    ScoreHeader *header = (ScoreHeader *)base;
+    if (created) {
+        memset(header, 0, sizeof(*header));
+        header->magic = SCORE_MAGIC;
+        header->version = SCORE_VERSION;
+        header->recordsize = sizeof(ScoreRecord);
+#ifdef _WIN32
+        fwrite(header, sizeof(*header), 1, storefile);
+        fflush(storefile);
+#endif
+    } else if (header->magic != SCORE_MAGIC ||
+               header->version != SCORE_VERSION ||
+               header->recordsize != sizeof(ScoreRecord)) {
+        S_ScoreUnmap();
+        return false;
+    }
+    nextslot = 0;
+    return true;
+}
+
+// Makes room for at least minslots records, in steps of SCORE_GROW. The
+// new slots read as zero, never written.
+static boolean S_ScoreGrow(uint minslots) {
+    const uint slots = (minslots + SCORE_GROW - 1) / SCORE_GROW * SCORE_GROW;
+    if (slots <= numslots && base != NULL)
+        return true;
+    const size_t size = sizeof(ScoreHeader) + (size_t)slots *
+        sizeof(ScoreRecord);
+#ifndef _WIN32
+    if (ftruncate(storefd, (off_t)size) != 0)
+        return false;
+    if (base != NULL) {
+        munmap(base, basesize);
+    }
+    void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      storefd, 0);
+    if (data == MAP_FAILED) {
+        base = NULL;
+        basesize = 0;
+        numslots = 0;
+        return false;
+    }
+    base = data;
+#else
+    Uint8 *data = SDL_realloc(base, size);
+    if (data == NULL)
+        return false;
+    memset(data + basesize, 0, size - basesize);
+    base = data;
+#endif
+    basesize = size;
+    numslots = slots;
+    return true;
+}
+
+static void S_ScoreUnmap(void) {
+#ifndef _WIN32
+    if (base != NULL) {
+        msync(base, basesize, MS_SYNC);
+        munmap(base, basesize);
+    }
+    if (storefd >= 0) {
+        close(storefd);
+        storefd = -1;
+    }
+#else
+    SDL_free(base);
+    if (storefile != NULL) {
+        fclose(storefile);
+        storefile = NULL;
+    }
+#endif
+    base = NULL;
+    basesize = 0;
+    numslots = 0;
+    if (replayfile != NULL) {
+        fclose(replayfile);
+        replayfile = NULL;
+    }
+}
+
+static int S_ScoreWriter(void *data) {
+    S_ScoreScan();
+    for (;;) {
+        const boolean stopping = SDL_AtomicGet(&quit) != 0;
+        int tail = SDL_AtomicGet(&queuetail);
+        while (tail != SDL_AtomicGet(&queuehead)) {
+            S_ScoreStore(&queue[tail & (SCORE_QUEUE - 1)]);
+            SDL_AtomicSet(&queuetail, ++tail);
+        }
+        if (stopping)
+            break;
+        SDL_Delay(SCORE_IDLE_MS);
+    }
+    return 0;
+}
+
+// Ranks the records already in the file. Slots that fail their checksum
+// were being written when the game went down and are left out.
+static void S_ScoreScan(void) {
+    ScoreRecord best[SCORE_TOP];
+    uint numbest = 0;
+    uint count = 0;
+    for (uint i = 0; i < numslots; i++) {
+        const ScoreRecord *record = S_ScoreSlot(i);
+        if (record->check == 0)
+            continue;
+        nextslot = i + 1;
+        if (record->check == S_ScoreCheck(record)) {
+            S_ScoreRank(best, &numbest, record);
+            count++;
+        }
+    }
+    SDL_AtomicLock(&toplock);
+    for (uint i = 0; i < numbest; i++) {
+        S_ScoreRank(top, &numtop, &best[i]);
+    }
+    SDL_AtomicUnlock(&toplock);
+    SDL_AtomicAdd(&numruns, (int)count);
+}
+
+// The replay goes first so the record never points past its end.
+static void S_ScoreStore(ScoreEntry *entry) {
+    ScoreRecord *record = &entry->record;
+    if (entry->replay.data != NULL && replayfile != NULL &&
+        fseek(replayfile, 0, SEEK_END) == 0) {
+        const long offset = ftell(replayfile);
+        if (offset >= 0 && S_ReplayWrite(&entry->replay, replayfile) &&
+            fflush(replayfile) == 0) {
+            record->replayoffset = (Uint64)offset;
+        }
+    }
+    S_ReplayFree(&entry->replay);
+    if (base == NULL || (nextslot == numslots && !S_ScoreGrow(numslots + 1)))
+        return; // out of disk, the run only lives in the top list
+    record->check = S_ScoreCheck(record);
+    ScoreRecord *slot = S_ScoreSlot(nextslot);
+    *slot = *record;
+    const size_t offset = (Uint8 *)slot - base;
+#ifndef _WIN32
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t start = offset / page * page;
+    msync(base + start, offset + sizeof(*slot) - start, MS_SYNC);
+#else
+    if (fseek(storefile, (long)offset, SEEK_SET) == 0) {
+        fwrite(slot, sizeof(*slot), 1, storefile);
+        fflush(storefile);
+    }
+#endif
+    nextslot++;
+}
+
+static ScoreRecord *S_ScoreSlot(uint slot) {
+    return (ScoreRecord *)(base + sizeof(ScoreHeader)) + slot;
+}
+
+// FNV-1a over the record up to its check, never 0.
+static Uint32 S_ScoreCheck(const ScoreRecord *record) {
+    const Uint8 *bytes = (const Uint8 *)record;
+    Uint32 hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(ScoreRecord, check); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+// Higher scores first, the earlier run of two with the same score.
+static void S_ScoreRank(ScoreRecord *list, uint *count,
+                        const ScoreRecord *record) {
+    uint i = *count;
+    while (i > 0 && (list[i - 1].score < record->score ||
+                     (list[i - 1].score == record->score &&
+                      list[i - 1].timestamp > record->timestamp))) {
+        i--;
+    }
+    if (i >= SCORE_TOP)
+        return;
+    const uint last = *count < SCORE_TOP ? *count : SCORE_TOP - 1;
+    memmove(&list[i + 1], &list[i], (last - i) * sizeof(ScoreRecord));
+    list[i] = *record;
+    if (*count < SCORE_TOP) {
+        (*count)++;
+    }
+}
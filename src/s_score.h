@@ -0,0 +1,76 @@
+/* =============================================================================
+** FlappyBirby, file: s_score.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_SCORE_H__
+#define __S_SCORE_H__
+
+#include "s_replay.h"
+
+// High score store. The file is a ScoreHeader followed by fixed size
+// ScoreRecords, only ever appended to, and mapped into memory. It grows
+// SCORE_GROW records at a time so new ones land in pages that are already
+// there. Every record carries a checksum and the ones that don't match are
+// skipped when the file is opened, so a crash loses at most the runs still
+// being written. The replay of each run is appended to FILE.replays and
+// the record keeps its offset.
+// Everything that touches the disk happens on a writer thread, and
+// S_ScoreAdd() only queues the run and ranks it among the best SCORE_TOP.
+#define SCORE_FILENAME "scores.fbhs"
+#define SCORE_MAGIC 0x53484246 // "FBHS" little endian
+#define SCORE_VERSION 1
+#define SCORE_TOP 5 // best runs kept in memory
+#define SCORE_GROW 1024 // records, 64 KB
+#define SCORE_QUEUE 64 // power of two, runs waiting for the writer
+#define SCORE_IDLE_MS 20 // writer sleep while the queue is empty
+#define SCORE_PATH_LEN 256
+#define SCORE_NO_REPLAY ((Uint64)-1)
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 recordsize; // sizeof(ScoreRecord)
+    Uint32 reserved[13];
+} ScoreHeader;
+
+// 64 bytes, records never straddle a page
+typedef struct {
+    Sint32 score;
+    Uint32 deathtick;
+    Uint64 seed;
+    Uint32 run;
+    Uint32 tickrate;
+    Sint64 timestamp; // seconds since 1970
+    Uint64 replayoffset; // in FILE.replays, SCORE_NO_REPLAY without one
+    Uint32 reserved[5];
+    Uint32 check; // of everything above, 0 in a slot never written
+} ScoreRecord;
+
+boolean S_ScoreOpen(const char *path);
+void S_ScoreClose(void);
+boolean S_ScoreIsOpen(void);
+boolean S_ScoreAdd(const SimState *sim, const Replay *replay);
+uint S_ScoreTop(ScoreRecord *records, uint maxrecords);
+uint S_ScoreRuns(void);
+
+#endif
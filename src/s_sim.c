@@ -0,0 +1,265 @@
+/* =============================================================================
+** FlappyBirby, file: s_sim.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_sim.h"
+
+static void S_GeneratePipes(SimState *sim);
+static void S_RecyclePipe(SimState *sim);
+static void S_Play(SimState *sim, const SimInput *input, uint *events);
+
+void S_Init(SimState *sim, uint tickrate, const SimLayout *layout,
+            Uint64 seed) {
+    sim->tickrate = tickrate > 0 ? tickrate : SIM_TICK_RATE;
+    if (layout != NULL) {
+        sim->layout = *layout;
+        S_ClampLayout(&sim->layout);
+    } else {
+        S_DefaultLayout(&sim->layout);
+    }
+    sim->seed = seed;
+    sim->run = 0;
+    S_Reset(sim);
+}
+
+void S_Reset(SimState *sim) {
+    U_RandomSeed(&sim->rng, sim->seed, sim->run);
+    sim->movefrac = 0;
+    sim->state = STATE_START;
+    sim->tick = 0;
+    sim->bird.x = SIM_BIRD_X;
+    sim->bird.y = SIM_BIRD_Y;
+    sim->bird.w = SIM_BIRD_SIZE;
+    sim->bird.h = SIM_BIRD_SIZE;
+    sim->groundx = 0;
+    sim->score = 0;
+    sim->hascollided = false;
+    S_GeneratePipes(sim);
+}
+
+uint S_Step(SimState *sim, const SimInput *input) {
+    uint events = SIM_EVENT_NONE;
+    switch (sim->state) {
+    case STATE_START:
+        if (input->flap) {
+            sim->state = STATE_PLAY;
+            events |= SIM_EVENT_START;
+        }
+        break;
+    case STATE_PLAY:
+        sim->tick++;
+        S_Play(sim, input, &events);
+        break;
+    case STATE_OVER:
+        if (input->flap) {
+            sim->run++;
+            S_Reset(sim);
+            events |= SIM_EVENT_RESET;
+        }
+        break;
+    }
+    return events;
+}
+
+// Returns how many whole pixels things move during one tick. Every tick is
+// 1000 / tickrate ms long, so the remainder is kept exactly in movefrac and
+// the speed comes out the same whatever the tick rate.
+uint S_Advance(uint *movefrac, uint tickrate) {
+    const uint den = SIM_SPEED_MS * tickrate;
+    *movefrac += 1000;
+    const uint move = *movefrac / den;
+    *movefrac %= den;
+    return move;
+}
+
+void S_DefaultLayout(SimLayout *layout) {
+    layout->spacing = SIM_PIPE_SPACING;
+    layout->gap = SIM_PIPE_GAP;
+    layout->rampscore = 0;
+}
+
+void S_ClampLayout(SimLayout *layout) {
+    if (layout->spacing < SIM_MIN_SPACING)
+        layout->spacing = SIM_MIN_SPACING;
+    if (layout->gap < SIM_MIN_GAP)
+        layout->gap = SIM_MIN_GAP;
+    if (layout->gap > SIM_HEIGHT / 2)
+        layout->gap = SIM_HEIGHT / 2;
+}
+
+// Spacing and gap for a pipe placed when the score is at the given value.
+// Depends on nothing but its arguments so that replays and batch lanes
+// come out the same.
+void S_LayoutAt(const SimLayout *layout, int score, int *spacing, int *gap) {
+    *spacing = layout->spacing;
+    *gap = layout->gap;
+    if (layout->rampscore > 0 && score > 0) {
+        const int shrink = (score / (int)layout->rampscore) * SIM_RAMP_STEP;
+        *spacing -= shrink;
+        *gap -= shrink;
+        if (*spacing < SIM_MIN_SPACING)
+            *spacing = SIM_MIN_SPACING;
+        if (*gap < SIM_MIN_GAP)
+            *gap = SIM_MIN_GAP;
+    }
+}
+
+// Vertical center of a new pipe's gap.
+int S_PipeCenter(RandomState *rng) {
+    return U_RandomRange(rng, SIM_HEIGHT / 2 - SIM_PIPE_GAP,
+                         SIM_HEIGHT / 2 + SIM_PIPE_GAP);
+}
+
+// Blends two consecutive ticks for drawing. Positions that jumped (ground
+// wrap, recycled pipes) are taken from cur as they are.
+void S_Interpolate(const SimState *prev, const SimState *cur, double alpha,
+                   SimState *out) {
+    *out = *cur;
+    if (prev->state != cur->state)
+        return;
+    out->bird.y = prev->bird.y + (int)((cur->bird.y - prev->bird.y) * alpha);
+    if (cur->groundx <= prev->groundx) {
+        out->groundx = prev->groundx +
+            (int)((cur->groundx - prev->groundx) * alpha);
+    }
+    for (uint i = 0; i < SIM_NUM_PIPES; i++) {
+        const int px = prev->pipes[i].x;
+        const int cx = cur->pipes[i].x;
+        if (cx <= px) {
+            out->pipes[i].x = px + (int)((cx - px) * alpha);
+        }
+    }
+}
+
+void S_PipeRects(const SDL_Rect *pipe, SDL_Rect *toprect, SDL_Rect *bottomrect,
+                 SDL_Rect *middlerect) {
+    toprect->x = pipe->x;
+    toprect->y = pipe->y - SIM_PIPE_HEIGHT - pipe->h;
+    toprect->w = SIM_PIPE_WIDTH;
+    toprect->h = SIM_PIPE_HEIGHT;
+
+    bottomrect->x = pipe->x;
+    bottomrect->y = pipe->y + pipe->h;
+    bottomrect->w = SIM_PIPE_WIDTH;
+    bottomrect->h = SIM_PIPE_HEIGHT;
+
+    middlerect->x = pipe->x + (SIM_PIPE_WIDTH / 2);
+    middlerect->y = bottomrect->y - (pipe->h * 2);
+    middlerect->w = 3;
+    middlerect->h = pipe->h * 2;
+}
+
+static void S_GeneratePipes(SimState *sim) {
+    for (uint i = 0; i < SIM_NUM_PIPES; i++) {
+        if (i > 0) {
+            sim->pipes[i].x = sim->pipes[i-1].x + sim->layout.spacing;
+        } else {
+            sim->pipes[0].x = sim->layout.spacing;
+        }
+        sim->pipes[i].y = S_PipeCenter(&sim->rng);
+        sim->pipes[i].w = SIM_PIPE_WIDTH;
+        sim->pipes[i].h = sim->layout.gap;
+    }
+    sim->headpipe = 0;
+}
+
+// Moves the leftmost pipe behind the rightmost one with a new gap.
+static void S_RecyclePipe(SimState *sim) {
+    const uint tail = (sim->headpipe + SIM_NUM_PIPES - 1) % SIM_NUM_PIPES;
+    SDL_Rect *pipe = &sim->pipes[sim->headpipe];
+    int spacing, gap;
+
+    S_LayoutAt(&sim->layout, sim->score, &spacing, &gap);
+    pipe->x = sim->pipes[tail].x + spacing;
+    pipe->y = S_PipeCenter(&sim->rng);
+    pipe->h = gap;
+    sim->headpipe = (sim->headpipe + 1) % SIM_NUM_PIPES;
+}
+
+static void S_Play(SimState *sim, const SimInput *input, uint *events) {
+    SDL_Rect *bird = &sim->bird;
+    const int scroll = S_Advance(&sim->movefrac, sim->tickrate);
+
+    if (input->flap) {
+        bird->y -= SIM_FLAP_HEIGHT;
+        *events |= SIM_EVENT_FLAP;
+    }
+    bird->y += scroll;
+    if (bird->y >= SIM_HEIGHT - (SIM_BIRD_SIZE / 2)) {
+        bird->y = SIM_HEIGHT - (SIM_BIRD_SIZE / 2);
+    }
+
+    if (sim->groundx <= -SIM_WIDTH) {
+        sim->groundx = 0;
+    } else {
+        sim->groundx -= scroll;
+    }
+
+    for (uint i = 0; i < SIM_NUM_PIPES; i++) {
+        sim->pipes[i].x -= scroll;
+    }
+    while (sim->pipes[sim->headpipe].x + SIM_PIPE_WIDTH < 0) {
+        S_RecyclePipe(sim);
+    }
+    uint first = 0;
+    while (first < SIM_NUM_PIPES) {
+        const SDL_Rect *pipe =
+            &sim->pipes[(sim->headpipe + first) % SIM_NUM_PIPES];
+        if (pipe->x + SIM_PIPE_WIDTH > bird->x)
+            break;
+        first++;
+    }
+
+    // Broad phase: going around the ring from headpipe the pipes are sorted
+    // by x, so only the ones starting at first whose span reaches into the
+    // bird's can touch it. Their top, bottom and middle rects then go
+    // through one batched test.
+    SDL_Rect rects[SIM_NEAR_PIPES * 3];
+    uint numrects = 0;
+    for (uint k = first; k < SIM_NUM_PIPES && numrects < SIZEOF_ARRAY(rects);
+         k++) {
+        const SDL_Rect *pipe = &sim->pipes[(sim->headpipe + k) % SIM_NUM_PIPES];
+        if (pipe->x >= bird->x + bird->w)
+            break;
+        S_PipeRects(pipe, &rects[numrects], &rects[numrects + 1],
+                    &rects[numrects + 2]);
+        // Widen the middle rect over the distance just scrolled so the pipe
+        // scores exactly once, however many pixels a tick moves it.
+        rects[numrects + 2].w = scroll + 1;
+        numrects += 3;
+    }
+    const Uint32 hits = U_CollideRects(bird, rects, numrects);
+    for (uint r = 0; r < numrects; r += 3) {
+        if (hits & (3u << r)) {
+            sim->hascollided = true;
+        }
+        if ((hits & (4u << r)) && bird->x > rects[r + 2].x) {
+            sim->score += 1;
+            *events |= SIM_EVENT_SCORE;
+        }
+    }
+    if (sim->hascollided) {
+        sim->state = STATE_OVER;
+        *events |= SIM_EVENT_DEATH;
+    }
+}
@@ -0,0 +1,110 @@
+/* =============================================================================
+** FlappyBirby, file: s_sim.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_SIM_H__
+#define __S_SIM_H__
+
+#include "u_utility.h"
+
+// Game rules, independent of any window or renderer. Nothing in here may
+// call into SDL so that it can be stepped headless as fast as the CPU allows.
+#define SIM_WIDTH 800
+#define SIM_HEIGHT 600
+// Pipes form a ring that is recycled to the right as they leave the screen.
+// It must hold enough of them to span the screen at SIM_MIN_SPACING.
+#define SIM_NUM_PIPES 8
+#define SIM_PIPE_WIDTH 150
+#define SIM_PIPE_HEIGHT 400
+#define SIM_PIPE_GAP 100 // half the opening between top and bottom pipe
+#define SIM_PIPE_SPACING 350
+// Closer than this and two pipes could overlap the bird at once
+#define SIM_MIN_SPACING (SIM_PIPE_WIDTH + SIM_BIRD_SIZE)
+#define SIM_MIN_GAP 50
+#define SIM_RAMP_STEP 10 // pixels taken off spacing and gap per ramp
+#define SIM_NEAR_PIPES 4 // most pipes that can overlap the bird horizontally
+#define SIM_BIRD_X 100
+#define SIM_BIRD_Y 250
+#define SIM_BIRD_SIZE 70
+#define SIM_FLAP_HEIGHT 50
+#define SIM_TICK_RATE 120 // default simulation ticks per second
+// Falling and scrolling move one pixel every SIM_SPEED_MS milliseconds
+#define SIM_SPEED_MS 6
+
+// Flags returned by S_Step() so the caller can play sounds etc.
+enum simevent_t {
+    SIM_EVENT_NONE = 0,
+    SIM_EVENT_START = 1 << 0,
+    SIM_EVENT_FLAP = 1 << 1,
+    SIM_EVENT_SCORE = 1 << 2,
+    SIM_EVENT_DEATH = 1 << 3,
+    SIM_EVENT_RESET = 1 << 4,
+};
+
+// Where new pipes go. With rampscore set, spacing and gap shrink by
+// SIM_RAMP_STEP every rampscore points until they reach the minimums.
+typedef struct {
+    int spacing; // between the left edges of neighbouring pipes
+    int gap; // half the opening, see SIM_PIPE_GAP
+    uint rampscore; // 0 keeps the layout fixed
+} SimLayout;
+
+typedef struct {
+    boolean flap; // space was pressed since the last step
+} SimInput;
+
+typedef struct {
+    uint tickrate; // fixed number of S_Step() calls per simulated second
+    uint movefrac; // sub-pixel motion carried over, in 1/tickrate ms
+    SimLayout layout;
+    // Run n draws its pipes from stream n of seed, so any run can be
+    // reproduced from those two numbers.
+    Uint64 seed;
+    uint run;
+    RandomState rng;
+    GameState state;
+    uint tick; // S_Step() calls since the flap that started the run
+    SDL_Rect bird;
+    // x is the left edge, y the gap center and h half the gap opening
+    SDL_Rect pipes[SIM_NUM_PIPES];
+    uint headpipe; // leftmost pipe, the next one to be recycled
+    int groundx;
+    int score;
+    boolean hascollided;
+} SimState;
+
+void S_Init(SimState *sim, uint tickrate, const SimLayout *layout,
+            Uint64 seed);
+void S_Reset(SimState *sim);
+uint S_Step(SimState *sim, const SimInput *input);
+uint S_Advance(uint *movefrac, uint tickrate);
+void S_DefaultLayout(SimLayout *layout);
+void S_ClampLayout(SimLayout *layout);
+void S_LayoutAt(const SimLayout *layout, int score, int *spacing, int *gap);
+int S_PipeCenter(RandomState *rng);
+void S_Interpolate(const SimState *prev, const SimState *cur, double alpha,
+                   SimState *out);
+void S_PipeRects(const SDL_Rect *pipe, SDL_Rect *toprect, SDL_Rect *bottomrect,
+                 SDL_Rect *middlerect);
+
+#endif
@@ -0,0 +1,97 @@
+/* =============================================================================
+** FlappyBirby, file: s_snap.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "s_snap.h"
+
+#include <stdlib.h>
+
+// All the memory is taken here, pushing never allocates.
+boolean S_SnapCreate(SnapRing *ring, uint capacity) {
+    ring->states = capacity > 0 ? malloc(capacity * sizeof(SimState)) : NULL;
+    ring->capacity = ring->states != NULL ? capacity : 0;
+    ring->head = ring->count = 0;
+    return ring->states != NULL;
+}
+
+void S_SnapDestroy(SnapRing *ring) {
+    free(ring->states);
+    ring->states = NULL;
+    ring->capacity = ring->head = ring->count = 0;
+}
+
+void S_SnapClear(SnapRing *ring) {
+    ring->head = ring->count = 0;
+}
+
+void S_SnapPush(SnapRing *ring, const SimState *sim) {
+    if (ring->capacity == 0)
+        return;
+    ring->states[ring->head] = *sim;
+    if (++ring->head == ring->capacity) {
+        ring->head = 0;
+    }
+    if (ring->count < ring->capacity) {
+        ring->count++;
+    }
+}
+
+// back 0 is the newest snapshot, NULL once back reaches past the oldest.
+const SimState *S_SnapPeek(const SnapRing *ring, uint back) {
+    if (back >= ring->count)
+        return NULL;
+    uint slot = ring->head + ring->capacity - 1 - back;
+    if (slot >= ring->capacity) {
+        slot -= ring->capacity;
+    }
+    return &ring->states[slot];
+}
+
+// Puts sim back to snapshot back and forgets it and everything newer, so
+// the game branches off from there. False leaves sim alone.
+boolean S_SnapRewind(SnapRing *ring, uint back, SimState *sim) {
+    const SimState *snap = S_SnapPeek(ring, back);
+    if (snap == NULL)
+        return false;
+    *sim = *snap;
+    ring->count -= back + 1;
+    ring->head = (uint)(snap - ring->states);
+    return true;
+}
+
+// One tick of a run that can be rewound. While rewind is held the sim goes
+// back a snapshot per tick and once the ring runs dry holds still at the
+// oldest, it never steps, so nothing that already happened fires again.
+// Otherwise the state is kept and the sim stepped. Returns S_Step()'s
+// events, SIM_EVENT_NONE while rewinding.
+uint S_SnapTick(SnapRing *ring, boolean rewind, SimState *sim,
+                const SimInput *input) {
+    if (rewind) {
+        S_SnapRewind(ring, 0, sim);
+        return SIM_EVENT_NONE;
+    }
+    if (sim->state == STATE_PLAY) {
+        S_SnapPush(ring, sim);
+    }
+    return S_Step(sim, input);
+}
@@ -0,0 +1,51 @@
+/* =============================================================================
+** FlappyBirby, file: s_snap.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __S_SNAP_H__
+#define __S_SNAP_H__
+
+#include "s_sim.h"
+
+#define SNAP_SECONDS 5 // default history kept for rewinding
+
+// The last capacity states a run went through, oldest overwritten first.
+// SimState holds all the mutable game state, RNG included, so a snapshot is
+// a plain struct copy and restoring one puts the game back exactly.
+typedef struct {
+    SimState *states;
+    uint capacity;
+    uint head; // slot the next snapshot goes into
+    uint count;
+} SnapRing;
+
+boolean S_SnapCreate(SnapRing *ring, uint capacity);
+void S_SnapDestroy(SnapRing *ring);
+void S_SnapClear(SnapRing *ring);
+void S_SnapPush(SnapRing *ring, const SimState *sim);
+const SimState *S_SnapPeek(const SnapRing *ring, uint back);
+boolean S_SnapRewind(SnapRing *ring, uint back, SimState *sim);
+uint S_SnapTick(SnapRing *ring, boolean rewind, SimState *sim,
+                const SimInput *input);
+
+#endif
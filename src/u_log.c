@@ -0,0 +1,583 @@
+/* =============================================================================
+** FlappyBirby, file: u_log.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "u_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define LOG_MAX_FORMATS 1024 // power of two, binary format ids
+#define LOG_LINE_LEN 1024
+#define LOG_SPEC_LEN 64
+
+typedef enum {
+    LEN_NONE = 0,
+    LEN_HH,
+    LEN_H,
+    LEN_L,
+    LEN_LL,
+    LEN_J,
+    LEN_Z,
+    LEN_T,
+    LEN_BIG_L,
+} LogLength;
+
+// One conversion of a format string, from its '%' up to the conversion
+typedef struct {
+    const char *flags;
+    int numflags;
+    const char *width; // digits, unless widthstar
+    int numwidth;
+    const char *precision; // digits after the '.', unless precisionstar
+    int numprecision;
+    boolean hasprecision;
+    boolean widthstar;
+    boolean precisionstar;
+    LogLength length;
+    char conversion;
+} LogSpec;
+
+typedef struct {
+    SDL_atomic_t sequence; // ring position the slot is ready for
+    Uint8 type;
+    Uint8 numargs;
+    Uint16 textlength;
+    Uint32 dropped;
+    Uint64 time;
+    const char *fmt;
+    Uint64 args[LOG_MAX_ARGS]; // strings are offsets into text
+    char text[LOG_MAX_TEXT];
+} LogSlot;
+
+static const char *U_LogParseSpec(const char *p, LogSpec *spec);
+static uint U_LogCapture(LogSlot *slot, const char *fmt, va_list args);
+static void U_LogDirect(LogType type, Uint32 dropped, const char *fmt,
+                        va_list args);
+static int U_LogWriter(void *data);
+static void U_LogDrain(void);
+static void U_LogText(const LogSlot *slot);
+static void U_LogBinary(const LogSlot *slot);
+
+static const char *typenames[NUM_LOG_TYPES] = {
+    "debug", "log", "message", "warning", "error",
+};
+static LogType loglevel = LOG_LOG;
+static LogSlot ring[LOG_RING_SLOTS];
+static SDL_atomic_t head; // next position producers claim
+static Uint32 tail = 0; // next position the writer reads
+static SDL_atomic_t running;
+static SDL_atomic_t quit;
+static SDL_atomic_t ringdropped; // messages the full ring turned away
+static SDL_Thread *writer = NULL;
+static FILE *binfile = NULL;
+static const char *formats[LOG_MAX_FORMATS]; // binary format ids
+static uint numformats = 0;
+static char lasterror[LOG_LINE_LEN]; // shown once the writer stops
+
+// binpath writes the binary format there instead of text to stdout and
+// stderr.
+boolean U_LogInit(LogType level, const char *binpath) {
+    loglevel = level;
+    if (binpath != NULL) {
+        const LogFileHeader header = {
+            LOG_BIN_MAGIC, LOG_BIN_VERSION, SDL_GetPerformanceFrequency(),
+        };
+        binfile = fopen(binpath, "wb");
+        if (binfile == NULL)
+            return false;
+        fwrite(&header, sizeof(header), 1, binfile);
+    }
+    for (uint i = 0; i < LOG_RING_SLOTS; i++) {
+        SDL_AtomicSet(&ring[i].sequence, (int)i);
+    }
+    SDL_AtomicSet(&head, 0);
+    SDL_AtomicSet(&quit, 0);
+    tail = 0;
+    writer = SDL_CreateThread(U_LogWriter, "LogWriter", NULL);
+    if (writer == NULL) {
+        if (binfile != NULL) {
+            fclose(binfile);
+            binfile = NULL;
+        }
+        return false;
+    }
+    SDL_AtomicSet(&running, 1);
+    return true;
+}
+
+// Writes what is still queued and stops the writer. The last error gets a
+// message box like every error used to, now that a frame can't be held up.
+void U_LogQuit(void) {
+    if (writer == NULL)
+        return;
+    SDL_AtomicSet(&running, 0);
+    SDL_AtomicSet(&quit, 1);
+    SDL_WaitThread(writer, NULL);
+    writer = NULL;
+    if (binfile != NULL) {
+        fclose(binfile);
+        binfile = NULL;
+    }
+    if (lasterror[0] != '\0') {
+        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", lasterror,
+                                 NULL);
+        lasterror[0] = '\0';
+    }
+}
+
+void U_LogWrite(LogSite *site, LogType type, const char *fmt, ...) {
+    if (type < loglevel)
+        return;
+    const int second = (int)(SDL_GetTicks() / 1000);
+    if (SDL_AtomicGet(&site->second) != second) {
+        SDL_AtomicSet(&site->second, second);
+        SDL_AtomicSet(&site->count, 0);
+    }
+    if (SDL_AtomicAdd(&site->count, 1) >= LOG_SITE_RATE) {
+        SDL_AtomicAdd(&site->dropped, 1);
+        return;
+    }
+    const Uint32 dropped = (Uint32)SDL_AtomicSet(&site->dropped, 0);
+
+    va_list args;
+    va_start(args, fmt);
+    if (!SDL_AtomicGet(&running)) {
+        U_LogDirect(type, dropped, fmt, args);
+        va_end(args);
+        return;
+    }
+    // Claim a slot, bounded multi-producer queue: a slot is free for
+    // position pos once its sequence got there
+    int pos = SDL_AtomicGet(&head);
+    LogSlot *slot;
+    for (;;) {
+        slot = &ring[(Uint32)pos & (LOG_RING_SLOTS - 1)];
+        const int diff = SDL_AtomicGet(&slot->sequence) - pos;
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&head, pos, pos + 1))
+                break;
+        } else if (diff < 0) {
+            SDL_AtomicAdd(&ringdropped, 1);
+            SDL_AtomicAdd(&site->dropped, (int)dropped);
+            va_end(args);
+            return;
+        }
+        pos = SDL_AtomicGet(&head);
+    }
+    slot->type = (Uint8)type;
+    slot->dropped = dropped;
+    slot->time = SDL_GetPerformanceCounter();
+    slot->fmt = fmt;
+    slot->numargs = (Uint8)U_LogCapture(slot, fmt, args);
+    va_end(args);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&slot->sequence, pos + 1);
+}
+
+const char *U_LogTypeName(LogType type) {
+    return type < NUM_LOG_TYPES ? typenames[type] : "?";
+}
+
+// Formats a captured message, conversions past numargs come out as they
+// are written. String offsets outside the textlength bytes of text, from a
+// damaged --logbin file, print as "(bad offset)". Returns the length like
+// snprintf().
+int U_LogFormat(char *out, size_t size, const char *fmt, const Uint64 *args,
+                uint numargs, const char *text, size_t textlength) {
+    size_t len = 0;
+    uint arg = 0;
+    const char *p = fmt;
+    while (*p != '\0') {
+        const char *percent = strchr(p, '%');
+        const size_t plain = percent != NULL ?
+            (size_t)(percent - p) : strlen(p);
+        if (len + 1 < size) {
+            const size_t room = size - len - 1;
+            memcpy(out + len, p, plain < room ? plain : room);
+        }
+        len += plain;
+        if (percent == NULL)
+            break;
+        if (percent[1] == '%') {
+            if (len + 1 < size) {
+                out[len] = '%';
+            }
+            len++;
+            p = percent + 2;
+            continue;
+        }
+
+        LogSpec spec;
+        p = U_LogParseSpec(percent, &spec);
+        const uint needed = 1 + spec.widthstar + spec.precisionstar;
+        if (spec.conversion == '\0' || arg + needed > numargs) {
+            // Unknown or not captured, keep the text
+            const size_t rest = strlen(percent);
+            if (len + 1 < size) {
+                const size_t room = size - len - 1;
+                memcpy(out + len, percent, rest < room ? rest : room);
+            }
+            len += rest;
+            break;
+        }
+        // A spec too long to rebuild, only seen in a damaged --logbin file,
+        // is copied as it is and its arguments skipped. The worst case is
+        // '%', flags, width, '.', precision, "ll", conversion and '\0'.
+        const size_t longest = 1 + (size_t)spec.numflags +
+            (spec.widthstar ? 11 : (size_t)spec.numwidth) + 1 +
+            (spec.precisionstar ? 11 : (size_t)spec.numprecision) + 4;
+        if (longest > LOG_SPEC_LEN) {
+            const size_t speclength = (size_t)(p - percent);
+            if (len + 1 < size) {
+                const size_t room = size - len - 1;
+                memcpy(out + len, percent,
+                       speclength < room ? speclength : room);
+            }
+            len += speclength;
+            arg += needed;
+            continue;
+        }
+        // Rebuild the conversion with the stars filled in and every integer
+        // widened to long long, which is how it was captured
+        char specbuf[LOG_SPEC_LEN];
+        int speclen = snprintf(specbuf, sizeof(specbuf), "%%%.*s",
+                               spec.numflags, spec.flags);
+        if (spec.widthstar) {
+            speclen += snprintf(specbuf + speclen, sizeof(specbuf) - speclen,
+                                "%d", (int)(Sint64)args[arg++]);
+        } else {
+            speclen += snprintf(specbuf + speclen, sizeof(specbuf) - speclen,
+                                "%.*s", spec.numwidth, spec.width);
+        }
+        if (spec.precisionstar) {
+            const int precision = (int)(Sint64)args[arg++];
+            if (precision >= 0) {
+                speclen += snprintf(specbuf + speclen,
+                                    sizeof(specbuf) - speclen, ".%d",
+                                    precision);
+            }
+        } else if (spec.hasprecision) {
+            speclen += snprintf(specbuf + speclen, sizeof(specbuf) - speclen,
+                                ".%.*s", spec.numprecision, spec.precision);
+        }
+        const Uint64 value = args[arg++];
+        char *dst = len < size ? out + len : NULL;
+        const size_t room = len < size ? size - len : 0;
+        int written = 0;
+        switch (spec.conversion) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            snprintf(specbuf + speclen, sizeof(specbuf) - speclen, "ll%c",
+                     spec.conversion);
+            if (spec.conversion == 'd' || spec.conversion == 'i') {
+                written = snprintf(dst, room, specbuf, (long long)value);
+            } else {
+                written = snprintf(dst, room, specbuf,
+                                   (unsigned long long)value);
+            }
+            break;
+        case 'c':
+            snprintf(specbuf + speclen, sizeof(specbuf) - speclen, "c");
+            written = snprintf(dst, room, specbuf, (int)value);
+            break;
+        case 'e': case 'E': case 'f': case 'F':
+        case 'g': case 'G': case 'a': case 'A': {
+            double real;
+            memcpy(&real, &value, sizeof(real));
+            snprintf(specbuf + speclen, sizeof(specbuf) - speclen, "%c",
+                     spec.conversion);
+            written = snprintf(dst, room, specbuf, real);
+            break;
+        }
+        case 's':
+            snprintf(specbuf + speclen, sizeof(specbuf) - speclen, "s");
+            written = snprintf(dst, room, specbuf, value < textlength ?
+                               text + value : "(bad offset)");
+            break;
+        case 'p':
+            snprintf(specbuf + speclen, sizeof(specbuf) - speclen, "p");
+            written = snprintf(dst, room, specbuf, (void *)(uintptr_t)value);
+            break;
+        default: // %n writes nothing
+            break;
+        }
+        len += written > 0 ? (size_t)written : 0;
+    }
+    if (size > 0) {
+        out[len < size ? len : size - 1] = '\0';
+    }
+    return (int)len;
+}
+
+// p is at a '%' that doesn't start "%%". Returns the first character after
+// the conversion, conversion is '\0' for anything not understood.
+static const char *U_LogParseSpec(const char *p, LogSpec *spec) {
+    memset(spec, 0, sizeof(*spec));
+    p++;
+    spec->flags = p;
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+        p++;
+    }
+    spec->numflags = (int)(p - spec->flags);
+    spec->width = p;
+    if (*p == '*') {
+        spec->widthstar = true;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+        spec->numwidth = (int)(p - spec->width);
+    }
+    if (*p == '.') {
+        spec->hasprecision = true;
+        p++;
+        spec->precision = p;
+        if (*p == '*') {
+            spec->precisionstar = true;
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                p++;
+            }
+            spec->numprecision = (int)(p - spec->precision);
+        }
+    }
+    switch (*p) {
+    case 'h':
+        spec->length = p[1] == 'h' ? LEN_HH : LEN_H;
+        p += spec->length == LEN_HH ? 2 : 1;
+        break;
+    case 'l':
+        spec->length = p[1] == 'l' ? LEN_LL : LEN_L;
+        p += spec->length == LEN_LL ? 2 : 1;
+        break;
+    case 'j': spec->length = LEN_J; p++; break;
+    case 'z': spec->length = LEN_Z; p++; break;
+    case 't': spec->length = LEN_T; p++; break;
+    case 'L': spec->length = LEN_BIG_L; p++; break;
+    default: break;
+    }
+    if (*p != '\0' && strchr("diuoxXcseEfFgGaApn", *p) != NULL) {
+        spec->conversion = *p++;
+    }
+    return p;
+}
+
+// Pulls every argument fmt asks for with the type it asks for, so what a
+// call passes is read the same way printf() would. Returns how many were
+// kept, everything past LOG_MAX_ARGS is left out.
+static uint U_LogCapture(LogSlot *slot, const char *fmt, va_list args) {
+    uint numargs = 0;
+    size_t textlength = 0;
+    const char *p = fmt;
+    while ((p = strchr(p, '%')) != NULL) {
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        LogSpec spec;
+        p = U_LogParseSpec(p, &spec);
+        const uint needed = 1 + spec.widthstar + spec.precisionstar;
+        if (spec.conversion == '\0' || numargs + needed > LOG_MAX_ARGS)
+            break;
+        if (spec.widthstar) {
+            slot->args[numargs++] = (Uint64)(Sint64)va_arg(args, int);
+        }
+        if (spec.precisionstar) {
+            slot->args[numargs++] = (Uint64)(Sint64)va_arg(args, int);
+        }
+        Uint64 value = 0;
+        switch (spec.conversion) {
+        case 'd': case 'i':
+            switch (spec.length) {
+            case LEN_HH: value = (Uint64)(Sint64)(signed char)va_arg(args, int); break;
+            case LEN_H: value = (Uint64)(Sint64)(short)va_arg(args, int); break;
+            case LEN_L: value = (Uint64)(Sint64)va_arg(args, long); break;
+            case LEN_LL: value = (Uint64)(Sint64)va_arg(args, long long); break;
+            case LEN_J: value = (Uint64)(Sint64)va_arg(args, intmax_t); break;
+            case LEN_Z: value = (Uint64)(Sint64)va_arg(args, ptrdiff_t); break;
+            case LEN_T: value = (Uint64)(Sint64)va_arg(args, ptrdiff_t); break;
+            default: value = (Uint64)(Sint64)va_arg(args, int); break;
+            }
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            switch (spec.length) {
+            case LEN_HH: value = (unsigned char)va_arg(args, unsigned int); break;
+            case LEN_H: value = (unsigned short)va_arg(args, unsigned int); break;
+            case LEN_L: value = va_arg(args, unsigned long); break;
+            case LEN_LL: value = va_arg(args, unsigned long long); break;
+            case LEN_J: value = va_arg(args, uintmax_t); break;
+            case LEN_Z: value = va_arg(args, size_t); break;
+            case LEN_T: value = (Uint64)va_arg(args, ptrdiff_t); break;
+            default: value = va_arg(args, unsigned int); break;
+            }
+            break;
+        case 'c':
+            value = (Uint64)(Sint64)va_arg(args, int);
+            break;
+        case 'e': case 'E': case 'f': case 'F':
+        case 'g': case 'G': case 'a': case 'A': {
+            const double real = spec.length == LEN_BIG_L ?
+                (double)va_arg(args, long double) : va_arg(args, double);
+            memcpy(&value, &real, sizeof(value));
+            break;
+        }
+        case 's': {
+            // Copied, the caller's buffer (SDL_GetError() and the like)
+            // may change before the writer gets to it
+            const char *string = va_arg(args, const char *);
+            if (string == NULL) {
+                string = "(null)";
+            }
+            size_t length = strlen(string);
+            if (textlength + length + 1 > LOG_MAX_TEXT) {
+                length = textlength < LOG_MAX_TEXT ?
+                    LOG_MAX_TEXT - textlength - 1 : 0;
+            }
+            if (textlength >= LOG_MAX_TEXT) {
+                value = LOG_MAX_TEXT - 1; // the empty string at the end
+                break;
+            }
+            memcpy(slot->text + textlength, string, length);
+            slot->text[textlength + length] = '\0';
+            value = textlength;
+            textlength += length + 1;
+            break;
+        }
+        case 'p':
+            value = (Uint64)(uintptr_t)va_arg(args, void *);
+            break;
+        default:
+            (void)va_arg(args, void *); // %n
+            break;
+        }
+        slot->args[numargs++] = value;
+    }
+    slot->text[LOG_MAX_TEXT - 1] = '\0';
+    slot->textlength = (Uint16)(textlength < LOG_MAX_TEXT ?
+                                textlength : LOG_MAX_TEXT);
+    return numargs;
+}
+
+// Without the writer thread, e.g. while the options are parsed.
+static void U_LogDirect(LogType type, Uint32 dropped, const char *fmt,
+                        va_list args) {
+    FILE *handle = type >= LOG_WRN ? stderr : stdout;
+    if (dropped > 0) {
+        fprintf(handle, "(%u similar messages suppressed)\n", dropped);
+    }
+    vfprintf(handle, fmt, args);
+}
+
+static int U_LogWriter(void *data) {
+    for (;;) {
+        const boolean stopping = SDL_AtomicGet(&quit) != 0;
+        U_LogDrain();
+        const int dropped = SDL_AtomicSet(&ringdropped, 0);
+        if (dropped > 0 && binfile == NULL) {
+            fprintf(stderr, "(%d messages dropped, log ring full)\n",
+                    dropped);
+        }
+        if (stopping)
+            break;
+        fflush(stdout);
+        fflush(stderr);
+        if (binfile != NULL) {
+            fflush(binfile);
+        }
+        SDL_Delay(LOG_IDLE_MS);
+    }
+    fflush(stdout);
+    fflush(stderr);
+    return 0;
+}
+
+// Everything published so far, in the order the slots were claimed.
+static void U_LogDrain(void) {
+    for (;;) {
+        LogSlot *slot = &ring[tail & (LOG_RING_SLOTS - 1)];
+        if (SDL_AtomicGet(&slot->sequence) != (int)(tail + 1))
+            return;
+        SDL_MemoryBarrierAcquire();
+        if (binfile != NULL) {
+            U_LogBinary(slot);
+        } else {
+            U_LogText(slot);
+        }
+        if (slot->type == LOG_ERR) {
+            U_LogFormat(lasterror, sizeof(lasterror), slot->fmt, slot->args,
+                        slot->numargs, slot->text, slot->textlength);
+        }
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&slot->sequence, (int)(tail + LOG_RING_SLOTS));
+        tail++;
+    }
+}
+
+static void U_LogText(const LogSlot *slot) {
+    char line[LOG_LINE_LEN];
+    FILE *handle = slot->type >= LOG_WRN ? stderr : stdout;
+    if (slot->dropped > 0) {
+        fprintf(handle, "(%u similar messages suppressed)\n", slot->dropped);
+    }
+    U_LogFormat(line, sizeof(line), slot->fmt, slot->args, slot->numargs,
+                slot->text, slot->textlength);
+    fputs(line, handle);
+}
+
+// Formats are written once and referred to by id afterwards. When the ids
+// run out they are handed out again from 0, logdump just replaces them.
+static void U_LogBinary(const LogSlot *slot) {
+    Uint16 id = 0;
+    while (id < numformats && formats[id] != slot->fmt) {
+        id++;
+    }
+    if (id == numformats) {
+        if (numformats == LOG_MAX_FORMATS) {
+            numformats = 0;
+            id = 0;
+        }
+        const Uint8 kind = LOG_RECORD_FORMAT;
+        const size_t length = strlen(slot->fmt);
+        const Uint16 fmtlength = (Uint16)(length < 0xFFFF ? length : 0xFFFF);
+        formats[numformats++] = slot->fmt;
+        fwrite(&kind, 1, 1, binfile);
+        fwrite(&id, sizeof(id), 1, binfile);
+        fwrite(&fmtlength, sizeof(fmtlength), 1, binfile);
+        fwrite(slot->fmt, 1, fmtlength, binfile);
+    }
+    const Uint8 kind = LOG_RECORD_MESSAGE;
+    fwrite(&kind, 1, 1, binfile);
+    fwrite(&slot->type, 1, 1, binfile);
+    fwrite(&id, sizeof(id), 1, binfile);
+    fwrite(&slot->time, sizeof(slot->time), 1, binfile);
+    fwrite(&slot->dropped, sizeof(slot->dropped), 1, binfile);
+    fwrite(&slot->numargs, 1, 1, binfile);
+    fwrite(slot->args, sizeof(Uint64), slot->numargs, binfile);
+    fwrite(&slot->textlength, sizeof(slot->textlength), 1, binfile);
+    fwrite(slot->text, 1, slot->textlength, binfile);
+}
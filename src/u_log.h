@@ -0,0 +1,96 @@
+/* =============================================================================
+** FlappyBirby, file: u_log.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __U_LOG_H__
+#define __U_LOG_H__
+
+#include "u_utility.h"
+
+// Asynchronous logger. The calling thread only copies the format pointer
+// and the arguments (strings by value) into a slot of a lock-free ring; a
+// writer thread started by U_LogInit() formats and writes them, as text or
+// in a binary format tools/logdump.c turns back into text. Every call site
+// is limited to LOG_SITE_RATE messages a second, a full ring drops
+// messages instead of waiting. Before U_LogInit() and after U_LogQuit()
+// messages are written right away.
+#define LOG_RING_SLOTS 1024 // power of two
+#define LOG_MAX_ARGS 8
+#define LOG_MAX_TEXT 160 // bytes of string arguments kept per message
+#define LOG_SITE_RATE 240
+#define LOG_IDLE_MS 5 // writer sleep while the ring is empty
+#define LOG_BIN_MAGIC 0x474C4246 // "FBLG"
+#define LOG_BIN_VERSION 1
+
+#define LOG_AT(type, fmt, ...) do { \
+        static LogSite logsite; \
+        U_LogWrite(&logsite, type, fmt, ##__VA_ARGS__); \
+    } while (0)
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_DBG, fmt, ##__VA_ARGS__)
+#define LOG_MESSAGE(fmt, ...) LOG_AT(LOG_MSG, fmt, ##__VA_ARGS__)
+#define LOG_WARNING(fmt, ...) LOG_AT(LOG_WRN, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_ERR, fmt, ##__VA_ARGS__)
+
+// In order of severity, messages below the level given to U_LogInit() are
+// dropped where they are made.
+typedef enum {
+    LOG_DBG = 0, // per frame detail
+    LOG_LOG,
+    LOG_MSG,
+    LOG_WRN,
+    LOG_ERR,
+    NUM_LOG_TYPES,
+} LogType;
+
+// State of one LOG_* call site for the rate limit
+typedef struct {
+    SDL_atomic_t second; // SDL_GetTicks() / 1000 the count is for
+    SDL_atomic_t count;
+    SDL_atomic_t dropped; // since the last message that got through
+} LogSite;
+
+// Binary log: a LogFileHeader, then records starting with a LogRecordKind
+// byte. All fields are in the byte order of the machine that wrote them.
+//   LOG_RECORD_FORMAT   Uint16 id, Uint16 length, the format string
+//   LOG_RECORD_MESSAGE  Uint8 type, Uint16 format id, Uint64 time,
+//                       Uint32 dropped, Uint8 numargs, Uint64 args[],
+//                       Uint16 textlength, text
+typedef enum {
+    LOG_RECORD_FORMAT = 1,
+    LOG_RECORD_MESSAGE,
+} LogRecordKind;
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint64 frequency; // of the message times
+} LogFileHeader;
+
+boolean U_LogInit(LogType level, const char *binpath);
+void U_LogQuit(void);
+void U_LogWrite(LogSite *site, LogType type, const char *fmt, ...);
+const char *U_LogTypeName(LogType type);
+int U_LogFormat(char *out, size_t size, const char *fmt, const Uint64 *args,
+                uint numargs, const char *text, size_t textlength);
+
+#endif
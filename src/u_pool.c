@@ -0,0 +1,188 @@
+/* =============================================================================
+** FlappyBirby, file: u_pool.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "u_pool.h"
+
+#include <stdlib.h>
+
+static int U_PoolThread(void *data);
+static void U_PoolWork(PoolWorker *worker);
+static boolean U_PoolTake(PoolWorker *worker, uint *index);
+static boolean U_PoolSteal(PoolWorker *worker);
+
+// numthreads counts the caller, 0 picks one per CPU.
+boolean U_PoolCreate(Pool *pool, uint numthreads) {
+    if (numthreads == 0)
+        numthreads = (uint)SDL_GetCPUCount();
+    if (numthreads > POOL_MAX_THREADS)
+        numthreads = POOL_MAX_THREADS;
+    pool->numworkers = numthreads > 0 ? numthreads : 1;
+    pool->generation = 0;
+    pool->active = 0;
+    pool->quit = false;
+    pool->mutex = SDL_CreateMutex();
+    pool->wake = SDL_CreateCond();
+    pool->done = SDL_CreateCond();
+    pool->workers = calloc(pool->numworkers, sizeof(PoolWorker));
+    if (pool->mutex == NULL || pool->wake == NULL || pool->done == NULL ||
+        pool->workers == NULL) {
+        U_PoolDestroy(pool);
+        return false;
+    }
+    for (uint i = 0; i < pool->numworkers; i++) {
+        pool->workers[i].index = i;
+        pool->workers[i].pool = pool;
+    }
+    // Worker 0 is whoever calls U_PoolRun()
+    for (uint i = 1; i < pool->numworkers; i++) {
+        pool->workers[i].thread = SDL_CreateThread(U_PoolThread, "PoolWorker",
+                                                   &pool->workers[i]);
+        if (pool->workers[i].thread == NULL) {
+            U_PoolDestroy(pool);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calls task(data, i) for every i below count and returns once all are done.
+void U_PoolRun(Pool *pool, PoolTask task, void *data, uint count) {
+    const uint n = pool->numworkers;
+    for (uint i = 0; i < n; i++) {
+        PoolWorker *worker = &pool->workers[i];
+        worker->begin = (uint)((Uint64)count * i / n);
+        worker->end = (uint)((Uint64)count * (i + 1) / n);
+    }
+    SDL_LockMutex(pool->mutex);
+    pool->task = task;
+    pool->data = data;
+    pool->active = n;
+    pool->generation++;
+    SDL_CondBroadcast(pool->wake);
+    SDL_UnlockMutex(pool->mutex);
+
+    U_PoolWork(&pool->workers[0]);
+
+    SDL_LockMutex(pool->mutex);
+    while (pool->active > 0) {
+        SDL_CondWait(pool->done, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+}
+
+void U_PoolDestroy(Pool *pool) {
+    if (pool->mutex != NULL && pool->workers != NULL) {
+        SDL_LockMutex(pool->mutex);
+        pool->quit = true;
+        SDL_CondBroadcast(pool->wake);
+        SDL_UnlockMutex(pool->mutex);
+        for (uint i = 1; i < pool->numworkers; i++) {
+            if (pool->workers[i].thread != NULL)
+                SDL_WaitThread(pool->workers[i].thread, NULL);
+        }
+    }
+    free(pool->workers);
+    if (pool->done != NULL)
+        SDL_DestroyCond(pool->done);
+    if (pool->wake != NULL)
+        SDL_DestroyCond(pool->wake);
+    if (pool->mutex != NULL)
+        SDL_DestroyMutex(pool->mutex);
+    pool->workers = NULL;
+    pool->done = pool->wake = NULL;
+    pool->mutex = NULL;
+}
+
+static int U_PoolThread(void *data) {
+    PoolWorker *worker = data;
+    Pool *pool = worker->pool;
+    uint seen = 0;
+    for (;;) {
+        SDL_LockMutex(pool->mutex);
+        while (pool->generation == seen && !pool->quit) {
+            SDL_CondWait(pool->wake, pool->mutex);
+        }
+        if (pool->quit) {
+            SDL_UnlockMutex(pool->mutex);
+            return 0;
+        }
+        seen = pool->generation;
+        SDL_UnlockMutex(pool->mutex);
+
+        U_PoolWork(worker);
+    }
+}
+
+static void U_PoolWork(PoolWorker *worker) {
+    Pool *pool = worker->pool;
+    uint index;
+    do {
+        while (U_PoolTake(worker, &index)) {
+            pool->task(pool->data, index);
+        }
+    } while (U_PoolSteal(worker));
+
+    SDL_LockMutex(pool->mutex);
+    if (--pool->active == 0) {
+        SDL_CondSignal(pool->done);
+    }
+    SDL_UnlockMutex(pool->mutex);
+}
+
+static boolean U_PoolTake(PoolWorker *worker, uint *index) {
+    boolean taken = false;
+    SDL_AtomicLock(&worker->lock);
+    if (worker->begin < worker->end) {
+        *index = worker->begin++;
+        taken = true;
+    }
+    SDL_AtomicUnlock(&worker->lock);
+    return taken;
+}
+
+// Moves the back half of the first non-empty range found into worker's own.
+// False once every other range has run dry.
+static boolean U_PoolSteal(PoolWorker *worker) {
+    Pool *pool = worker->pool;
+    for (uint i = 1; i < pool->numworkers; i++) {
+        PoolWorker *victim =
+            &pool->workers[(worker->index + i) % pool->numworkers];
+        uint begin = 0, end = 0;
+        SDL_AtomicLock(&victim->lock);
+        if (victim->begin < victim->end) {
+            end = victim->end;
+            begin = victim->end - (victim->end - victim->begin + 1) / 2;
+            victim->end = begin;
+        }
+        SDL_AtomicUnlock(&victim->lock);
+        if (begin < end) {
+            SDL_AtomicLock(&worker->lock);
+            worker->begin = begin;
+            worker->end = end;
+            SDL_AtomicUnlock(&worker->lock);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,68 @@
+/* =============================================================================
+** FlappyBirby, file: u_pool.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __U_POOL_H__
+#define __U_POOL_H__
+
+#include "u_utility.h"
+
+// Thread pool for data-parallel loops. U_PoolRun() splits the indices into
+// one contiguous range per worker. A worker takes indices from the front of
+// its own range and, once that is empty, steals the back half of another
+// worker's, so uneven tasks still keep every core busy.
+#define POOL_MAX_THREADS 256
+#define POOL_CACHE_LINE 64
+
+typedef void (*PoolTask)(void *data, uint index);
+
+struct pool_t;
+
+typedef struct {
+    SDL_SpinLock lock; // guards begin and end
+    uint begin; // next index the owner takes
+    uint end; // thieves take from here down
+    uint index;
+    SDL_Thread *thread;
+    struct pool_t *pool;
+    Uint8 pad[POOL_CACHE_LINE]; // keeps neighbouring locks apart
+} PoolWorker;
+
+typedef struct pool_t {
+    uint numworkers; // including the thread calling U_PoolRun()
+    PoolWorker *workers;
+    SDL_mutex *mutex;
+    SDL_cond *wake;
+    SDL_cond *done;
+    uint generation; // bumped for every U_PoolRun()
+    uint active; // workers still busy with the current run
+    boolean quit;
+    PoolTask task;
+    void *data;
+} Pool;
+
+boolean U_PoolCreate(Pool *pool, uint numthreads);
+void U_PoolRun(Pool *pool, PoolTask task, void *data, uint count);
+void U_PoolDestroy(Pool *pool);
+
+#endif
@@ -0,0 +1,221 @@
+/* =============================================================================
+** FlappyBirby, file: u_prof.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include "u_prof.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PROF_NOT_RUN (~(Uint64)0)
+
+// Counter ticks are nanoseconds on Linux, 32 bits would wrap after 4.3 s
+typedef struct {
+    Uint64 start;
+    Uint64 length;
+    Uint64 offset[PROF_MAX_PHASES]; // first entry, from start
+    Uint64 ticks[PROF_MAX_PHASES]; // summed over the frame
+} ProfFrame;
+
+static int U_CompareTicks(const void *a, const void *b);
+static uint U_ProfOldest(uint *count);
+static double U_ProfMs(Uint64 ticks);
+
+static const char *const *phasenames = NULL;
+static uint numphases = 0;
+static double frequency = 1.0;
+// Single producer: frames are written by the main loop, then published by
+// bumping written, so a reader never sees a frame that is half filled in.
+static ProfFrame ring[PROF_RING_FRAMES];
+static SDL_atomic_t written;
+static ProfFrame current;
+static Uint64 opened[PROF_MAX_PHASES];
+static Uint64 sorted[PROF_RING_FRAMES]; // scratch for percentiles
+
+// False when there are more than PROF_MAX_PHASES phases.
+boolean U_ProfInit(const char *const *names, uint count) {
+    if (count > PROF_MAX_PHASES)
+        return false;
+    phasenames = names;
+    numphases = count;
+    frequency = (double)SDL_GetPerformanceFrequency();
+    U_ProfReset();
+    return true;
+}
+
+// Drops every recorded frame, the next U_ProfFrame() starts over.
+void U_ProfReset(void) {
+    SDL_AtomicSet(&written, 0);
+    current.start = 0;
+}
+
+// Closes the running frame and starts the next one.
+void U_ProfFrame(void) {
+    const Uint64 now = SDL_GetPerformanceCounter();
+    if (current.start != 0) {
+        const int index = SDL_AtomicGet(&written);
+        current.length = now - current.start;
+        ring[(uint)index % PROF_RING_FRAMES] = current;
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&written, index + 1);
+    }
+    current.start = now;
+    for (uint i = 0; i < numphases; i++) {
+        current.offset[i] = PROF_NOT_RUN;
+        current.ticks[i] = 0;
+    }
+}
+
+void U_ProfBegin(uint phase) {
+    const Uint64 now = SDL_GetPerformanceCounter();
+    if (phase >= numphases || current.start == 0)
+        return;
+    opened[phase] = now;
+    if (current.offset[phase] == PROF_NOT_RUN) {
+        current.offset[phase] = now - current.start;
+    }
+}
+
+void U_ProfEnd(uint phase) {
+    const Uint64 now = SDL_GetPerformanceCounter();
+    if (phase >= numphases || current.start == 0)
+        return;
+    current.ticks[phase] += now - opened[phase];
+}
+
+uint U_ProfNumPhases(void) {
+    return numphases;
+}
+
+const char *U_ProfName(uint phase) {
+    return phase < numphases ? phasenames[phase] : "";
+}
+
+// Fills stats for every phase over the last frames frames, plus one more
+// entry after the phases for the whole frame. Returns how many frames were
+// looked at.
+uint U_ProfStats(ProfStats *stats, uint frames) {
+    uint count;
+    uint first = U_ProfOldest(&count);
+    if (frames < count) {
+        first += count - frames;
+        count = frames;
+    }
+    for (uint p = 0; p <= numphases; p++) {
+        Uint64 total = 0;
+        uint n = 0;
+        for (uint i = 0; i < count; i++) {
+            const ProfFrame *frame = &ring[(first + i) % PROF_RING_FRAMES];
+            if (p == numphases) {
+                sorted[n++] = frame->length;
+            } else if (frame->offset[p] != PROF_NOT_RUN) {
+                sorted[n++] = frame->ticks[p];
+            }
+        }
+        stats[p].min = stats[p].avg = stats[p].p50 = stats[p].p99 = 0.0;
+        if (n == 0)
+            continue;
+        qsort(sorted, n, sizeof(sorted[0]), U_CompareTicks);
+        for (uint i = 0; i < n; i++) {
+            total += sorted[i];
+        }
+        stats[p].min = U_ProfMs(sorted[0]);
+        stats[p].avg = U_ProfMs(total) / n;
+        stats[p].p50 = U_ProfMs(sorted[n / 2]);
+        stats[p].p99 = U_ProfMs(sorted[(n * 99) / 100]);
+    }
+    return count;
+}
+
+// Chrome trace event format, load it in chrome://tracing or Perfetto. A
+// phase that ran several times in a frame is one event starting at its
+// first entry and lasting its summed time.
+boolean U_ProfWriteTrace(const char *path) {
+    FILE *handle = fopen(path, "w");
+    if (handle == NULL)
+        return false;
+    uint count;
+    const uint first = U_ProfOldest(&count);
+    const Uint64 origin = count > 0 ? ring[first % PROF_RING_FRAMES].start : 0;
+    const char *sep = "";
+    fprintf(handle, "{\"traceEvents\":[\n");
+    for (uint i = 0; i < count; i++) {
+        const ProfFrame *frame = &ring[(first + i) % PROF_RING_FRAMES];
+        const double ts = U_ProfMs(frame->start - origin) * 1000.0;
+        fprintf(handle, "%s{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", sep, ts,
+                U_ProfMs(frame->length) * 1000.0);
+        sep = ",\n";
+        for (uint p = 0; p < numphases; p++) {
+            if (frame->offset[p] == PROF_NOT_RUN)
+                continue;
+            fprintf(handle, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                    "\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", sep, phasenames[p],
+                    ts + U_ProfMs(frame->offset[p]) * 1000.0,
+                    U_ProfMs(frame->ticks[p]) * 1000.0);
+        }
+    }
+    fprintf(handle, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(handle) == 0;
+}
+
+// One row per frame, one column of milliseconds per phase.
+boolean U_ProfWriteCsv(const char *path) {
+    FILE *handle = fopen(path, "w");
+    if (handle == NULL)
+        return false;
+    uint count;
+    const uint first = U_ProfOldest(&count);
+    fprintf(handle, "frame,total");
+    for (uint p = 0; p < numphases; p++) {
+        fprintf(handle, ",%s", phasenames[p]);
+    }
+    fprintf(handle, "\n");
+    for (uint i = 0; i < count; i++) {
+        const ProfFrame *frame = &ring[(first + i) % PROF_RING_FRAMES];
+        fprintf(handle, "%u,%.4f", i, U_ProfMs(frame->length));
+        for (uint p = 0; p < numphases; p++) {
+            fprintf(handle, ",%.4f", U_ProfMs(frame->ticks[p]));
+        }
+        fprintf(handle, "\n");
+    }
+    return fclose(handle) == 0;
+}
+
+static int U_CompareTicks(const void *a, const void *b) {
+    const Uint64 x = *(const Uint64 *)a;
+    const Uint64 y = *(const Uint64 *)b;
+    return (x > y) - (x < y);
+}
+
+// Index of the oldest frame still in the ring and how many there are.
+static uint U_ProfOldest(uint *count) {
+    const uint total = (uint)SDL_AtomicGet(&written);
+    SDL_MemoryBarrierAcquire();
+    *count = total < PROF_RING_FRAMES ? total : PROF_RING_FRAMES;
+    return total - *count;
+}
+
+static double U_ProfMs(Uint64 ticks) {
+    return (double)ticks * 1000.0 / frequency;
+}
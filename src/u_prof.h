@@ -0,0 +1,55 @@
+/* =============================================================================
+** FlappyBirby, file: u_prof.h Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#ifndef __U_PROF_H__
+#define __U_PROF_H__
+
+#include "u_utility.h"
+
+// Frame profiler. Phases are timed with SDL_GetPerformanceCounter() between
+// U_ProfBegin() and U_ProfEnd(); a phase entered several times in a frame
+// adds up. Every U_ProfFrame() publishes the finished frame into a ring of
+// the last PROF_RING_FRAMES frames.
+#define PROF_MAX_PHASES 16
+#define PROF_RING_FRAMES 4096 // a bit over a minute at 60 fps
+
+typedef struct {
+    double min; // milliseconds, over the frames the phase ran in
+    double avg;
+    double p50;
+    double p99;
+} ProfStats;
+
+boolean U_ProfInit(const char *const *names, uint count);
+void U_ProfReset(void);
+void U_ProfFrame(void);
+void U_ProfBegin(uint phase);
+void U_ProfEnd(uint phase);
+uint U_ProfNumPhases(void);
+const char *U_ProfName(uint phase);
+uint U_ProfStats(ProfStats *stats, uint frames);
+boolean U_ProfWriteTrace(const char *path);
+boolean U_ProfWriteCsv(const char *path);
+
+#endif
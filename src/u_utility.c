@@ -27,14 +27,79 @@
 #include <stdlib.h>
 #include <time.h>
 #include <math.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
+#define PCG_MULT 6364136223846793005ULL
+#define WAIT_SPIN_MS 2 // how late SDL_Delay() may wake up
+
+void U_RandomSeed(RandomState *rng, Uint64 seed, Uint64 stream) {
+    rng->state = 0;
+    rng->inc = (stream << 1) | 1;
+    U_RandomNext(rng);
+    rng->state += seed;
+    U_RandomNext(rng);
+}
+
+Uint32 U_RandomNext(RandomState *rng) {
+    const Uint64 old = rng->state;
+    rng->state = old * PCG_MULT + rng->inc;
+    const Uint32 xorshifted = (Uint32)(((old >> 18) ^ old) >> 27);
+    const Uint32 rot = (Uint32)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+// Uniform in [0, bound) without modulo bias: multiply into 64 bits and only
+// retry in the rare case the low half falls below 2^32 % bound.
+Uint32 U_RandomBelow(RandomState *rng, Uint32 bound) {
+    Uint64 m = (Uint64)U_RandomNext(rng) * bound;
+    Uint32 low = (Uint32)m;
+    if (low < bound) {
+        const Uint32 threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            m = (Uint64)U_RandomNext(rng) * bound;
+            low = (Uint32)m;
+        }
+    }
+    return (Uint32)(m >> 32);
+}
+
+// Uniform in [min, max], both inclusive.
+int U_RandomRange(RandomState *rng, int min, int max) {
+    const Uint32 span = (Uint32)max - (Uint32)min + 1;
+    if (span == 0)
+        return (int)U_RandomNext(rng);
+    return (int)((Uint32)min + U_RandomBelow(rng, span));
+}
+
+// Skips delta numbers in O(log delta) steps, e.g. to split one stream
+// between threads.
+void U_RandomAdvance(RandomState *rng, Uint64 delta) {
+    Uint64 curmult = PCG_MULT, curplus = rng->inc;
+    Uint64 accmult = 1, accplus = 0;
+    while (delta > 0) {
+        if (delta & 1) {
+            accmult *= curmult;
+            accplus = accplus * curmult + curplus;
+        }
+        curplus = (curmult + 1) * curplus;
+        curmult *= curmult;
+        delta >>= 1;
+    }
+    rng->state = accmult * rng->state + accplus;
+}
+
+// Shared generator seeded from the clock for things that need not be
+// reproducible.
 int U_RandomNum(const int min, const int max) {
     static boolean hasran = false;
+    static RandomState rng;
     if (!hasran) {
         hasran = true;
-        srand(time(NULL));
+        U_RandomSeed(&rng, (Uint64)time(NULL), 0);
     }
-    return min + rand() & (max + 1 - min);
+    return U_RandomRange(&rng, min, max);
 }
 
 int U_RandomColor() {
@@ -48,36 +113,63 @@ boolean U_IsColliding(SDL_Rect *rect1, SDL_Rect *rect2) {
             rect1->y + rect1->h > rect2->y);
 }
 
-#define MAX_LOG_LEN 512
-void U_LogMessage(LogType type, const char *fmt, ...) {
-	char logbuf[MAX_LOG_LEN];
-	FILE *handle;
-	Uint32 flags;
-	switch (type) {
-	case LOG_LOG:
-		handle = stdout;
-		break;
-	case LOG_MSG:
-		handle = stdout;
-		break;
-	case LOG_ERR:
-		handle = stderr;
-		flags = SDL_MESSAGEBOX_ERROR;
-		break;
-	default:
-		return;
-	}
-
-	va_list args;
-	va_start(args, fmt);
-	snprintf(logbuf, MAX_LOG_LEN, fmt, args);
-	va_end(args);
-
-	if (handle == stdout) {
-		fprintf(handle, logbuf);
-	} else {
-		fprintf(handle, logbuf);
-		SDL_ShowSimpleMessageBox(flags, "Error", logbuf, NULL);
-	}
+// Same test as U_IsColliding() against up to 32 rects at once. Bit i of the
+// result is set when rects[i] overlaps rect. With SSE2 four rects are
+// transposed into x/y/w/h vectors and tested together.
+Uint32 U_CollideRects(const SDL_Rect *rect, const SDL_Rect *rects, uint count) {
+    Uint32 mask = 0;
+    uint i = 0;
+    if (count > 32)
+        count = 32;
+#if defined(__SSE2__)
+    const __m128i x1 = _mm_set1_epi32(rect->x);
+    const __m128i y1 = _mm_set1_epi32(rect->y);
+    const __m128i r1 = _mm_set1_epi32(rect->x + rect->w);
+    const __m128i b1 = _mm_set1_epi32(rect->y + rect->h);
+    for (; i + 4 <= count; i += 4) {
+        // Rows are x, y, w, h of one rect, transpose to one field per vector
+        const __m128i a = _mm_loadu_si128((const __m128i *)&rects[i]);
+        const __m128i b = _mm_loadu_si128((const __m128i *)&rects[i + 1]);
+        const __m128i c = _mm_loadu_si128((const __m128i *)&rects[i + 2]);
+        const __m128i d = _mm_loadu_si128((const __m128i *)&rects[i + 3]);
+        const __m128i ab0 = _mm_unpacklo_epi32(a, b);
+        const __m128i cd0 = _mm_unpacklo_epi32(c, d);
+        const __m128i ab1 = _mm_unpackhi_epi32(a, b);
+        const __m128i cd1 = _mm_unpackhi_epi32(c, d);
+        const __m128i x2 = _mm_unpacklo_epi64(ab0, cd0);
+        const __m128i y2 = _mm_unpackhi_epi64(ab0, cd0);
+        const __m128i w2 = _mm_unpacklo_epi64(ab1, cd1);
+        const __m128i h2 = _mm_unpackhi_epi64(ab1, cd1);
+        const __m128i hit = _mm_and_si128(
+            _mm_and_si128(_mm_cmplt_epi32(x1, _mm_add_epi32(x2, w2)),
+                          _mm_cmpgt_epi32(r1, x2)),
+            _mm_and_si128(_mm_cmplt_epi32(y1, _mm_add_epi32(y2, h2)),
+                          _mm_cmpgt_epi32(b1, y2)));
+        mask |= (Uint32)_mm_movemask_ps(_mm_castsi128_ps(hit)) << i;
+    }
+#endif
+    for (; i < count; i++) {
+        if (U_IsColliding((SDL_Rect *)rect, (SDL_Rect *)&rects[i]))
+            mask |= 1u << i;
+    }
+    return mask;
 }
 
+// Sleeps most of the way to deadline, a SDL_GetPerformanceCounter() value,
+// and spins the rest since SDL_Delay() alone misses it by a millisecond or
+// more.
+void U_WaitUntil(Uint64 deadline) {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 spin = frequency * WAIT_SPIN_MS / 1000;
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now + spin < deadline) {
+        const Uint32 ms = (Uint32)((deadline - spin - now) * 1000 / frequency);
+        if (ms == 0)
+            break;
+        SDL_Delay(ms);
+        now = SDL_GetPerformanceCounter();
+    }
+    while (now < deadline) {
+        now = SDL_GetPerformanceCounter();
+    }
+}
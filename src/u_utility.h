@@ -30,8 +30,6 @@
 #include <stdarg.h>
 
 #define SIZEOF_ARRAY(X) sizeof(X)/sizeof(X[0])
-#define LOG_MESSAGE(fmt, ...) U_LogMessage(LOG_MSG, fmt, ##__VA_ARGS__)
-#define LOG_ERROR(fmt, ...) U_LogMessage(LOG_ERR, fmt, ##__VA_ARGS__)
 
 #undef bool
 #undef true
@@ -52,15 +50,22 @@ enum gamestate_t {
 };
 typedef enum gamestate_t GameState;
 
-typedef enum {
-	LOG_LOG,
-	LOG_MSG,
-	LOG_ERR,
-} LogType;
+// PCG32 generator. Games that need reproducible numbers keep their own;
+// every stream gives an independent sequence for the same seed.
+typedef struct {
+    Uint64 state;
+    Uint64 inc; // selects the stream, always odd
+} RandomState;
 
+void U_RandomSeed(RandomState *rng, Uint64 seed, Uint64 stream);
+Uint32 U_RandomNext(RandomState *rng);
+Uint32 U_RandomBelow(RandomState *rng, Uint32 bound);
+int U_RandomRange(RandomState *rng, int min, int max);
+void U_RandomAdvance(RandomState *rng, Uint64 delta);
 int U_RandomNum(const int min, const int max);
 int U_RandomColor();
 boolean U_IsColliding(SDL_Rect *rect1, SDL_Rect *rect2);
-void U_LogMessage(LogType type, const char *fmt, ...);
+Uint32 U_CollideRects(const SDL_Rect *rect, const SDL_Rect *rects, uint count);
+void U_WaitUntil(Uint64 deadline);
 
 #endif
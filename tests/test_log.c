@@ -0,0 +1,72 @@
+/* =============================================================================
+** FlappyBirby, file: test_log.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "u_log.h"
+
+// U_LogFormat() on messages as logdump reads them back from a --logbin
+// file, damaged ones included.
+static int failures = 0;
+
+static void T_Expect(const char *fmt, const Uint64 *args, uint numargs,
+                     const char *text, size_t textlength,
+                     const char *expected) {
+    char line[256];
+    U_LogFormat(line, sizeof(line), fmt, args, numargs, text, textlength);
+    if (strcmp(line, expected) != 0) {
+        printf("FAIL \"%s\": got \"%s\", expected \"%s\"\n", fmt, line,
+               expected);
+        failures++;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char text[] = "birby";
+    const Uint64 args[] = { 42, 0, 1000 };
+    T_Expect("%d %s\n", args, 2, text, sizeof(text), "42 birby\n");
+    T_Expect("%05u|%-4d|\n", args, 2, text, sizeof(text), "00042|0   |\n");
+    T_Expect("%s\n", &args[2], 1, text, sizeof(text), "(bad offset)\n");
+    T_Expect("%d %d\n", args, 1, text, sizeof(text), "42 %d\n");
+
+    // Longer than the buffer the spec is rebuilt in, copied as it is and
+    // the conversions after it still line up with their arguments
+    char spec[256], fmt[300], expected[300];
+    memset(spec, '0', 200);
+    spec[200] = '\0';
+    snprintf(fmt, sizeof(fmt), "%%%sd %%s", spec);
+    snprintf(expected, sizeof(expected), "%%%sd birby", spec);
+    T_Expect(fmt, args, 2, text, sizeof(text), expected);
+    memset(spec, '-', 40);
+    memset(spec + 40, '9', 40);
+    spec[80] = '\0';
+    snprintf(fmt, sizeof(fmt), "%%%.40s.%sx|%%d", spec, spec + 40);
+    snprintf(expected, sizeof(expected), "%%%.40s.%sx|0", spec, spec + 40);
+    T_Expect(fmt, args, 2, text, sizeof(text), expected);
+
+    printf("test_log: %d failed\n", failures);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/* =============================================================================
+** FlappyBirby, file: test_snap.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "s_snap.h"
+
+// Rewinding with S_SnapTick(): back one snapshot per tick, then holding
+// still at the oldest for as long as rewind stays held, without a single
+// event firing again.
+#define TEST_CAPACITY 60
+#define TEST_TICKS 200
+#define TEST_SEED 1
+
+static int failures = 0;
+
+static void T_Check(boolean ok, const char *what) {
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    SnapRing ring;
+    if (!S_SnapCreate(&ring, TEST_CAPACITY)) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    SimLayout layout;
+    S_DefaultLayout(&layout);
+    SimState sim;
+    S_Init(&sim, SIM_TICK_RATE, &layout, TEST_SEED);
+
+    // Flap whenever the bird sinks below where it started
+    SimInput input = { true };
+    for (uint i = 0; i < TEST_TICKS && sim.state != STATE_OVER; i++) {
+        S_SnapTick(&ring, false, &sim, &input);
+        input.flap = sim.bird.y > SIM_BIRD_Y;
+    }
+    T_Check(sim.tick > TEST_CAPACITY, "run longer than the ring");
+    const SimState oldest = *S_SnapPeek(&ring, TEST_CAPACITY - 1);
+
+    uint events = SIM_EVENT_NONE;
+    uint rewound = 0;
+    uint tick = sim.tick;
+    for (uint i = 0; i < TEST_CAPACITY * 3; i++) {
+        input.flap = i % 2 == 0;
+        events |= S_SnapTick(&ring, true, &sim, &input);
+        rewound += sim.tick < tick;
+        T_Check(sim.tick <= tick, "rewind never goes forward");
+        tick = sim.tick;
+    }
+    T_Check(events == SIM_EVENT_NONE, "no events while rewinding");
+    T_Check(rewound == TEST_CAPACITY, "one snapshot per tick");
+    T_Check(memcmp(&sim, &oldest, sizeof(sim)) == 0, "held at the oldest");
+    T_Check(ring.count == 0, "ring used up");
+
+    // Let go and the run carries on from there
+    input.flap = false;
+    S_SnapTick(&ring, false, &sim, &input);
+    T_Check(sim.tick == oldest.tick + 1 && ring.count == 1,
+            "steps again once let go");
+
+    S_SnapDestroy(&ring);
+    printf("test_snap: %d failed\n", failures);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
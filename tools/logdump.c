@@ -0,0 +1,141 @@
+/* =============================================================================
+** FlappyBirby, file: logdump.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+
+#include "u_log.h"
+
+// Turns a binary log written with --logbin back into text, one message a
+// line with its time in seconds since the log was opened and its level.
+//   usage: logdump <log file>
+#define MAX_FORMATS 1024 // at least LOG_MAX_FORMATS in u_log.c
+#define LINE_LEN 1024
+
+static char *formats[MAX_FORMATS];
+
+static void T_Read(void *data, size_t size, FILE *file) {
+    if (size > 0 && fread(data, size, 1, file) != 1) {
+        fprintf(stderr, "Log ends in the middle of a record\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <log file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    FILE *file = fopen(argv[1], "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    LogFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != LOG_BIN_MAGIC || header.version != LOG_BIN_VERSION) {
+        fprintf(stderr, "%s is not a log of this version and byte order\n",
+                argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    Uint64 first = 0;
+    boolean started = false;
+    int kind;
+    while ((kind = fgetc(file)) != EOF) {
+        Uint16 id;
+        if (kind == LOG_RECORD_FORMAT) {
+            Uint16 length;
+            T_Read(&id, sizeof(id), file);
+            T_Read(&length, sizeof(length), file);
+            if (id >= MAX_FORMATS) {
+                fprintf(stderr, "Format id %u out of range\n", id);
+                return EXIT_FAILURE;
+            }
+            free(formats[id]);
+            formats[id] = malloc((size_t)length + 1);
+            if (formats[id] == NULL) {
+                fprintf(stderr, "Out of memory\n");
+                return EXIT_FAILURE;
+            }
+            T_Read(formats[id], length, file);
+            formats[id][length] = '\0';
+            continue;
+        } else if (kind != LOG_RECORD_MESSAGE) {
+            fprintf(stderr, "Unknown record %d\n", kind);
+            return EXIT_FAILURE;
+        }
+        Uint8 type;
+        Uint64 time;
+        Uint32 dropped;
+        Uint8 numargs;
+        Uint64 args[LOG_MAX_ARGS];
+        Uint16 textlength;
+        char text[LOG_MAX_TEXT + 1];
+        T_Read(&type, 1, file);
+        T_Read(&id, sizeof(id), file);
+        T_Read(&time, sizeof(time), file);
+        T_Read(&dropped, sizeof(dropped), file);
+        T_Read(&numargs, 1, file);
+        if (numargs > LOG_MAX_ARGS) {
+            fprintf(stderr, "Corrupt message record\n");
+            return EXIT_FAILURE;
+        }
+        T_Read(args, sizeof(Uint64) * numargs, file);
+        T_Read(&textlength, sizeof(textlength), file);
+        if (textlength > LOG_MAX_TEXT) {
+            fprintf(stderr, "Corrupt message record\n");
+            return EXIT_FAILURE;
+        }
+        T_Read(text, textlength, file);
+        text[textlength] = '\0';
+
+        if (!started) {
+            first = time;
+            started = true;
+        }
+        char line[LINE_LEN];
+        if (id < MAX_FORMATS && formats[id] != NULL) {
+            U_LogFormat(line, sizeof(line), formats[id], args, numargs, text,
+                        textlength);
+        } else {
+            snprintf(line, sizeof(line), "(format %u missing)\n", id);
+        }
+        if (dropped > 0) {
+            printf("%12.6f %-7s (%u similar messages suppressed)\n",
+                   (double)(time - first) / header.frequency,
+                   U_LogTypeName(type), dropped);
+        }
+        printf("%12.6f %-7s %s", (double)(time - first) / header.frequency,
+               U_LogTypeName(type), line);
+        const size_t length = strlen(line);
+        if (length == 0 || line[length - 1] != '\n') {
+            putchar('\n');
+        }
+    }
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,257 @@
+/* =============================================================================
+** FlappyBirby, file: packer.c Created 10/17/2026
+**
+** Copyright 2026 Brian Hoffpauir TX, USA
+** All rights reserved.
+**
+** Redistribution and use of this source file, with or without modification, is
+** permitted provided that the following conditions are met:
+**
+** 1. Redistributions of this source file must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+** WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO
+** EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+** PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+** OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+** WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+** OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+** ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+** =============================================================================
+**/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include "a_pak.h"
+
+// Offline asset packer. Decodes the sprites into one RGBA atlas, converts
+// the sounds to the device format the game opens the mixer with and writes
+// everything into a single bundle the game maps without decoding.
+//   usage: packer <assets dir> <output file>
+#define ATLAS_MAX_WIDTH 2048
+#define ATLAS_PADDING 1
+#define MAX_ENTRIES 16
+
+static const char *sprites[] = {
+    "bgTex.webp", "ground.webp", "birbTile.webp", "pipe.webp",
+};
+static const char *sounds[] = {
+    "flap.wav", "score.wav", "lose.wav",
+};
+static const char *files[] = {
+    "FlappyBirdy.ttf",
+};
+
+static PakEntry entries[MAX_ENTRIES];
+static Uint32 numentries = 0;
+
+static PakEntry *T_AddEntry(const char *name, PakType type) {
+    if (numentries == MAX_ENTRIES) {
+        fprintf(stderr, "Too many entries\n");
+        exit(EXIT_FAILURE);
+    }
+    PakEntry *entry = &entries[numentries++];
+    memset(entry, 0, sizeof(*entry));
+    strncpy(entry->name, name, PAK_NAME_LEN - 1);
+    entry->type = type;
+    return entry;
+}
+
+static void T_Path(char *path, size_t size, const char *dir, const char *name) {
+    snprintf(path, size, "%s/%s", dir, name);
+}
+
+// Simple shelf packer, sprites are placed tallest first.
+static SDL_Surface *T_BuildAtlas(const char *dir) {
+    SDL_Surface *images[SIZEOF_ARRAY(sprites)];
+    PakEntry *placed[SIZEOF_ARRAY(sprites)];
+    uint order[SIZEOF_ARRAY(sprites)];
+    const uint count = SIZEOF_ARRAY(sprites);
+    char path[512];
+
+    for (uint i = 0; i < count; i++) {
+        T_Path(path, sizeof(path), dir, sprites[i]);
+        SDL_Surface *loaded = IMG_Load(path);
+        if (loaded == NULL) {
+            fprintf(stderr, "Could not load %s: %s\n", path, IMG_GetError());
+            exit(EXIT_FAILURE);
+        }
+        images[i] = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (images[i] == NULL) {
+            fprintf(stderr, "Could not convert %s: %s\n", path, SDL_GetError());
+            exit(EXIT_FAILURE);
+        }
+        placed[i] = T_AddEntry(sprites[i], PAK_SPRITE);
+        order[i] = i;
+    }
+    for (uint i = 1; i < count; i++) {
+        for (uint j = i; j > 0 && images[order[j]]->h > images[order[j-1]]->h;
+             j--) {
+            const uint tmp = order[j];
+            order[j] = order[j-1];
+            order[j-1] = tmp;
+        }
+    }
+
+    int x = 0, y = 0, shelfh = 0, atlasw = 0;
+    for (uint i = 0; i < count; i++) {
+        SDL_Surface *image = images[order[i]];
+        if (x > 0 && x + image->w > ATLAS_MAX_WIDTH) {
+            x = 0;
+            y += shelfh + ATLAS_PADDING;
+            shelfh = 0;
+        }
+        placed[order[i]]->x = x;
+        placed[order[i]]->y = y;
+        placed[order[i]]->w = image->w;
+        placed[order[i]]->h = image->h;
+        x += image->w + ATLAS_PADDING;
+        if (image->h > shelfh)
+            shelfh = image->h;
+        if (x > atlasw)
+            atlasw = x;
+    }
+
+    SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasw, y + shelfh,
+                                                        32,
+                                                        SDL_PIXELFORMAT_RGBA32);
+    if (atlas == NULL) {
+        fprintf(stderr, "Could not create atlas: %s\n", SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+    for (uint i = 0; i < count; i++) {
+        SDL_Rect dst = { (int)placed[i]->x, (int)placed[i]->y,
+                         (int)placed[i]->w, (int)placed[i]->h };
+        SDL_SetSurfaceBlendMode(images[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(images[i], NULL, atlas, &dst);
+        SDL_FreeSurface(images[i]);
+    }
+    return atlas;
+}
+
+static Uint8 *T_LoadSound(const char *path, Uint32 *length) {
+    SDL_AudioSpec spec;
+    Uint8 *buf = NULL;
+    Uint32 len = 0;
+    if (SDL_LoadWAV(path, &spec, &buf, &len) == NULL) {
+        fprintf(stderr, "Could not load %s: %s\n", path, SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq,
+                          PAK_AUDIO_FORMAT, PAK_AUDIO_CHANNELS,
+                          PAK_AUDIO_FREQ) < 0) {
+        fprintf(stderr, "Could not convert %s: %s\n", path, SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+    cvt.len = (int)len;
+    cvt.buf = malloc((size_t)len * (cvt.len_mult > 0 ? cvt.len_mult : 1));
+    if (cvt.buf == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(cvt.buf, buf, len);
+    SDL_FreeWAV(buf);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        fprintf(stderr, "Could not convert %s: %s\n", path, SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+    *length = cvt.needed ? (Uint32)cvt.len_cvt : len;
+    return cvt.buf;
+}
+
+static Uint32 T_Align(Uint32 offset) {
+    return (offset + PAK_ALIGN - 1) & ~(Uint32)(PAK_ALIGN - 1);
+}
+
+static void T_Write(FILE *out, Uint32 offset, const void *data, size_t size) {
+    if (fseek(out, (long)offset, SEEK_SET) != 0 ||
+        (size > 0 && fwrite(data, 1, size, out) != size)) {
+        fprintf(stderr, "Write failed\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <assets dir> <output file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *dir = argv[1];
+    char path[512];
+    void *blobs[MAX_ENTRIES] = { NULL };
+
+    SDL_Surface *atlas = T_BuildAtlas(dir);
+    for (uint i = 0; i < SIZEOF_ARRAY(sounds); i++) {
+        T_Path(path, sizeof(path), dir, sounds[i]);
+        PakEntry *entry = T_AddEntry(sounds[i], PAK_SOUND);
+        blobs[entry - entries] = T_LoadSound(path, &entry->length);
+    }
+    for (uint i = 0; i < SIZEOF_ARRAY(files); i++) {
+        T_Path(path, sizeof(path), dir, files[i]);
+        PakEntry *entry = T_AddEntry(files[i], PAK_FILE);
+        size_t size = 0;
+        blobs[entry - entries] = SDL_LoadFile(path, &size);
+        if (blobs[entry - entries] == NULL) {
+            fprintf(stderr, "Could not load %s: %s\n", path, SDL_GetError());
+            return EXIT_FAILURE;
+        }
+        entry->length = (Uint32)size;
+    }
+
+    PakHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PAK_MAGIC;
+    header.version = PAK_VERSION;
+    header.numentries = numentries;
+    header.atlaswidth = (Uint32)atlas->w;
+    header.atlasheight = (Uint32)atlas->h;
+    header.atlasoffset = T_Align(sizeof(header) + numentries * sizeof(PakEntry));
+    header.audiofreq = PAK_AUDIO_FREQ;
+    header.audioformat = PAK_AUDIO_FORMAT;
+    header.audiochannels = PAK_AUDIO_CHANNELS;
+
+    Uint32 offset = T_Align(header.atlasoffset +
+                            header.atlaswidth * header.atlasheight * 4);
+    for (Uint32 i = 0; i < numentries; i++) {
+        if (entries[i].type == PAK_SPRITE)
+            continue;
+        entries[i].offset = offset;
+        offset = T_Align(offset + entries[i].length);
+    }
+
+    FILE *out = fopen(argv[2], "wb");
+    if (out == NULL) {
+        fprintf(stderr, "Could not open %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    T_Write(out, 0, &header, sizeof(header));
+    T_Write(out, sizeof(header), entries, numentries * sizeof(PakEntry));
+    for (int row = 0; row < atlas->h; row++) {
+        T_Write(out, header.atlasoffset + row * header.atlaswidth * 4,
+                (const Uint8 *)atlas->pixels + row * atlas->pitch,
+                header.atlaswidth * 4);
+    }
+    for (Uint32 i = 0; i < numentries; i++) {
+        if (blobs[i] == NULL)
+            continue;
+        T_Write(out, entries[i].offset, blobs[i], entries[i].length);
+        if (entries[i].type == PAK_SOUND) {
+            free(blobs[i]);
+        } else {
+            SDL_free(blobs[i]);
+        }
+    }
+    fclose(out);
+    printf("%s: %ux%u atlas, %u entries, %u bytes\n", argv[2],
+           header.atlaswidth, header.atlasheight, numentries, offset);
+    SDL_FreeSurface(atlas);
+    return EXIT_SUCCESS;
+}
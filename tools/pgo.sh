@@ -0,0 +1,87 @@
+#!/bin/sh
+# Profile-guided build: instruments the game, trains it headless on recorded
+# runs and the bench scenarios, rebuilds with the profile and prints the fps
+# of every scenario next to a plain release build with the same LTO setting.
+#
+#   tools/pgo.sh [REPLAY..]
+#
+# REPLAY files may hold several runs each, by default the archive the high
+# scores keep in build/. PGO_BUILD_DIR (default build-pgo), PGO_LTO (ON or
+# OFF), BENCH_FRAMES and BENCH_RUNS (best of, default 3) tune it.
+set -e
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+out=${PGO_BUILD_DIR:-$root/build-pgo}
+lto=${PGO_LTO:-OFF}
+frames=${BENCH_FRAMES:-3000}
+runs=${BENCH_RUNS:-3}
+scenarios="idle play restart ghosts"
+jobs=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)
+export SDL_VIDEODRIVER=dummy SDL_AUDIODRIVER=dummy SDL_RENDER_DRIVER=software
+
+[ $# -gt 0 ] || set -- "$root/build/scores.fbhs.replays"
+corpus=
+for replay in "$@"; do
+    if [ -f "$replay" ]; then
+        dir=$(cd "$(dirname "$replay")" && pwd)
+        corpus="$corpus $dir/$(basename "$replay")"
+    else
+        echo "pgo: no replays in $replay, skipped" >&2
+    fi
+done
+
+build() { # DIR PGO
+    cmake -S "$root" -B "$1" -DCMAKE_BUILD_TYPE=Release -DFLAPPY_LTO="$lto" \
+        -DFLAPPY_PGO="$2" -DFLAPPY_PGO_DIR="$out/profile" >/dev/null
+    cmake --build "$1" --target FlappyBirby pak -j"$jobs" >/dev/null
+}
+
+# Best fps of $runs runs per scenario, one "scenario fps" line each
+bench() { # DIR
+    for s in $scenarios; do
+        best=0
+        i=0
+        while [ $i -lt "$runs" ]; do
+            fps=$(cd "$1" && ./FlappyBirby --bench "$s" --frames "$frames" |
+                sed -n 's/^bench .* \([0-9.]*\) fps$/\1/p')
+            if [ -z "$fps" ]; then
+                echo "pgo: bench $s failed in $1" >&2
+                exit 1
+            fi
+            best=$(echo "$fps $best" | awk '{ print ($1 > $2 ? $1 : $2) }')
+            i=$((i + 1))
+        done
+        echo "$s $best"
+    done
+}
+
+echo "pgo: release build" >&2
+build "$out/release" ""
+echo "pgo: instrumented build" >&2
+cmake -E remove_directory "$out/profile"
+build "$out/pgo" GENERATE
+
+echo "pgo: training" >&2
+if [ -n "$corpus" ]; then
+    # Exercises the simulation the way recorded runs played it
+    (cd "$out/pgo" && ./FlappyBirby --verify $corpus) >&2 ||
+        echo "pgo: some replays did not verify, trained anyway" >&2
+fi
+for s in $scenarios; do
+    (cd "$out/pgo" && ./FlappyBirby --bench "$s" --frames "$frames") >/dev/null
+done
+if ls "$out/profile"/*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -o "$out/profile/default.profdata" \
+        "$out/profile"/*.profraw
+fi
+
+echo "pgo: optimized build" >&2
+build "$out/pgo" USE
+
+echo "pgo: measuring, best of $runs" >&2
+bench "$out/release" >"$out/release.fps"
+bench "$out/pgo" >"$out/pgo.fps"
+echo "$out/pgo/FlappyBirby, lto $lto, $frames frames:"
+paste "$out/release.fps" "$out/pgo.fps" | awk '
+    BEGIN { printf "%-10s %10s %10s %9s\n", "fps", "release", "pgo", "speedup" }
+    { printf "%-10s %10.1f %10.1f %8.2fx\n", $1, $2, $4, $4 / $2 }'